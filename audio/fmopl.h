@@ -249,6 +249,7 @@ public:
 	int readBuffer(int16 *buffer, const int numSamples);
 	int getRate() const;
 	bool endOfData() const { return false; }
+	virtual bool isStereo() const = 0;
 
 protected:
 	// OPL API
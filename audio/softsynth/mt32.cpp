@@ -40,6 +40,7 @@
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/osd_message_queue.h"
+#include "common/queue.h"
 
 #include "graphics/fontman.h"
 #include "graphics/surface.h"
@@ -113,6 +114,56 @@ private:
 
 	int _outputRate;
 
+	// Render-ahead mode, enabled by setting "mt32_render_ahead" to the
+	// number of milliseconds to synthesize ahead of the mixer. A timer
+	// proc renders into the ring buffer, and the mixer callback only
+	// copies out of it. The ring positions are counts of stereo frames
+	// since opening, and _ringMutex is only held to read or update them.
+	//
+	// The timer proc shares the timer thread with every other timer proc,
+	// including the engine's own music timer, which waits while it renders.
+	// So it ticks often and renders at most two ticks' worth each time:
+	// enough to catch up after an underrun, but never the whole render-ahead
+	// amount at once. A longer render-ahead only buys more slack against
+	// the mixer, it does not make the ticks longer.
+	enum {
+		kMaxRenderAheadMs = 1000,
+		kMinRenderTickMs = 5,
+		kMaxRenderTickMs = 10
+	};
+
+	int16 *_ring;
+	uint32 _ringFrames;
+	uint32 _ringRead, _ringWrite;
+	uint32 _renderAheadFrames;
+	uint32 _renderTickFrames;
+	uint32 _underruns;
+	Common::Mutex _ringMutex;
+	Common::Mutex _renderMutex;
+
+	// MIDI sent from outside the render loop, to be played when rendering
+	// reaches the given ring position. Positions only grow with the mixer
+	// position, so the queue is in order. Guarded by _ringMutex.
+	struct QueuedEvent {
+		uint32 frame;
+		uint32 msg;
+		byte *sysex;
+		uint16 sysexLength;
+	};
+	Common::Queue<QueuedEvent> _eventQueue;
+
+	// The engine's timer callback, called from the render-ahead timer proc
+	// through tickProc, so events sent from it can be told apart
+	Common::TimerManager::TimerProc _engineTimerProc;
+	void *_engineTimerParam;
+	bool _inRenderTick;
+
+	static void renderAheadProc(void *refCon);
+	static void tickProc(void *refCon);
+	void renderAhead(uint32 maxFrames);
+	void queueEvent(uint32 msg, const byte *sysex, uint16 sysexLength);
+	void clearEventQueue();
+
 protected:
 	void generateSamples(int16 *buf, int len);
 
@@ -125,12 +176,14 @@ public:
 	void send(uint32 b);
 	void setPitchBendRange(byte channel, uint range);
 	void sysEx(const byte *msg, uint16 length);
+	void setTimerCallback(void *timer_param, Common::TimerManager::TimerProc timer_proc);
 
 	uint32 property(int prop, uint32 param);
 	MidiChannel *allocateChannel();
 	MidiChannel *getPercussionChannel();
 
 	// AudioStream API
+	int readBuffer(int16 *data, const int numSamples);
 	bool isStereo() const { return true; }
 	int getRate() const { return _outputRate; }
 };
@@ -150,6 +203,15 @@ MidiDriver_MT32::MidiDriver_MT32(Audio::Mixer *mixer) : MidiDriver_Emulated(mixe
 	_outputRate = 0;
 	_controlData = nullptr;
 	_pcmData = nullptr;
+	_ring = nullptr;
+	_ringFrames = 0;
+	_ringRead = _ringWrite = 0;
+	_renderAheadFrames = 0;
+	_renderTickFrames = 0;
+	_underruns = 0;
+	_engineTimerProc = nullptr;
+	_engineTimerParam = nullptr;
+	_inRenderTick = false;
 }
 
 MidiDriver_MT32::~MidiDriver_MT32() {
@@ -221,12 +283,42 @@ int MidiDriver_MT32::open() {
 
 	MidiDriver_Emulated::open();
 
+	int renderAheadMs = ConfMan.hasKey("mt32_render_ahead") ? ConfMan.getInt("mt32_render_ahead") : 0;
+	if (renderAheadMs > kMaxRenderAheadMs) {
+		warning("MT-32 render-ahead of %d ms is too long, using %d ms", renderAheadMs, (int)kMaxRenderAheadMs);
+		renderAheadMs = kMaxRenderAheadMs;
+	}
+	if (renderAheadMs > 0) {
+		_renderAheadFrames = (uint32)_outputRate * renderAheadMs / 1000;
+
+		// Leave room for a full render chunk on top of the render-ahead amount,
+		// and use a power of two size so positions can simply be masked
+		_ringFrames = 1;
+		while (_ringFrames < _renderAheadFrames + 1024)
+			_ringFrames <<= 1;
+		_ring = new int16[_ringFrames * 2];
+		_ringRead = _ringWrite = 0;
+		_underruns = 0;
+
+		// Render a bit before the mixer needs it, then keep topping it up in
+		// small steps, see kMaxRenderTickMs
+		renderAhead(_renderAheadFrames);
+		int tickMs = CLIP<int>(renderAheadMs / 4, kMinRenderTickMs, kMaxRenderTickMs);
+		_renderTickFrames = (uint32)_outputRate * tickMs * 2 / 1000;
+		g_system->getTimerManager()->installTimerProc(renderAheadProc, tickMs * 1000, this, "MT32render");
+	}
+
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
 	return 0;
 }
 
 void MidiDriver_MT32::send(uint32 b) {
+	if (_ring && !_inRenderTick) {
+		queueEvent(b, nullptr, 0);
+		return;
+	}
+
 	Common::StackLock lock(_mutex);
 	_service.playMsg(b);
 }
@@ -244,6 +336,11 @@ void MidiDriver_MT32::setPitchBendRange(byte channel, uint range) {
 
 void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 	if (msg[0] == 0xf0) {
+		if (_ring && !_inRenderTick) {
+			queueEvent(0, msg, length);
+			return;
+		}
+
 		Common::StackLock lock(_mutex);
 		_service.playSysex(msg, length);
 	} else {
@@ -271,6 +368,16 @@ void MidiDriver_MT32::close() {
 	// Detach the mixer callback handler
 	_mixer->stopHandle(_mixerSoundHandle);
 
+	if (_ring) {
+		g_system->getTimerManager()->removeTimerProc(renderAheadProc);
+
+		Common::StackLock renderLock(_renderMutex);
+		debug(1, "MT-32 render-ahead: %u underruns", _underruns);
+		delete[] _ring;
+		_ring = nullptr;
+		clearEventQueue();
+	}
+
 	Common::StackLock lock(_mutex);
 	_service.closeSynth();
 	_service.freeContext();
@@ -285,6 +392,138 @@ void MidiDriver_MT32::generateSamples(int16 *data, int len) {
 	_service.renderBit16s(data, len);
 }
 
+void MidiDriver_MT32::setTimerCallback(void *timer_param, Common::TimerManager::TimerProc timer_proc) {
+	_engineTimerProc = timer_proc;
+	_engineTimerParam = timer_param;
+	MidiDriver_Emulated::setTimerCallback(this, timer_proc ? tickProc : nullptr);
+}
+
+void MidiDriver_MT32::tickProc(void *refCon) {
+	MidiDriver_MT32 *driver = (MidiDriver_MT32 *)refCon;
+
+	// Events sent from the engine's callback are already at the right place
+	// in the rendered output. Another thread sending during this window would
+	// just have its event played immediately rather than queued.
+	Common::TimerManager::TimerProc timerProc = driver->_engineTimerProc;
+	if (!timerProc)
+		return;
+
+	driver->_inRenderTick = true;
+	(*timerProc)(driver->_engineTimerParam);
+	driver->_inRenderTick = false;
+}
+
+void MidiDriver_MT32::renderAheadProc(void *refCon) {
+	MidiDriver_MT32 *driver = (MidiDriver_MT32 *)refCon;
+	driver->renderAhead(driver->_renderTickFrames);
+}
+
+void MidiDriver_MT32::renderAhead(uint32 maxFrames) {
+	Common::StackLock renderLock(_renderMutex);
+	if (!_ring)
+		return;
+
+	uint32 readPos, writePos;
+	{
+		Common::StackLock lock(_ringMutex);
+		readPos = _ringRead;
+		writePos = _ringWrite;
+	}
+
+	uint32 endPos = writePos + maxFrames;
+	while (writePos - readPos < _renderAheadFrames && writePos != endPos) {
+		// Render in chunks up to the end of the ring, so the mixer can start
+		// using the first of them while the rest are being rendered
+		uint32 offset = writePos & (_ringFrames - 1);
+		uint32 frames = MIN<uint32>(_renderAheadFrames - (writePos - readPos), 512);
+		frames = MIN<uint32>(frames, endPos - writePos);
+		frames = MIN<uint32>(frames, _ringFrames - offset);
+
+		// Play the queued events that are due at this position, and stop the
+		// chunk at the next one. munt then only ever gets events to play
+		// immediately, in the order they are to be heard, mixed with those
+		// the engine's timer sends while rendering.
+		Common::Queue<QueuedEvent> dueEvents;
+		{
+			Common::StackLock lock(_ringMutex);
+			while (!_eventQueue.empty() && (int32)(_eventQueue.front().frame - writePos) <= 0)
+				dueEvents.push(_eventQueue.pop());
+			if (!_eventQueue.empty())
+				frames = MIN<uint32>(frames, _eventQueue.front().frame - writePos);
+		}
+
+		while (!dueEvents.empty()) {
+			QueuedEvent event = dueEvents.pop();
+			Common::StackLock lock(_mutex);
+			if (event.sysex) {
+				_service.playSysex(event.sysex, event.sysexLength);
+				delete[] event.sysex;
+			} else {
+				_service.playMsg(event.msg);
+			}
+		}
+
+		MidiDriver_Emulated::readBuffer(_ring + offset * 2, frames * 2);
+		writePos += frames;
+
+		Common::StackLock lock(_ringMutex);
+		_ringWrite = writePos;
+		readPos = _ringRead;
+	}
+}
+
+void MidiDriver_MT32::queueEvent(uint32 msg, const byte *sysex, uint16 sysexLength) {
+	QueuedEvent event;
+	event.msg = msg;
+	event.sysex = nullptr;
+	event.sysexLength = sysexLength;
+	if (sysex) {
+		event.sysex = new byte[sysexLength];
+		memcpy(event.sysex, sysex, sysexLength);
+	}
+
+	// Play events a fixed render-ahead time after the mixer's current
+	// position, which is never before what has already been rendered
+	Common::StackLock lock(_ringMutex);
+	event.frame = _ringRead + _renderAheadFrames;
+	_eventQueue.push(event);
+}
+
+void MidiDriver_MT32::clearEventQueue() {
+	Common::StackLock lock(_ringMutex);
+	while (!_eventQueue.empty())
+		delete[] _eventQueue.pop().sysex;
+}
+
+int MidiDriver_MT32::readBuffer(int16 *data, const int numSamples) {
+	if (!_ring)
+		return MidiDriver_Emulated::readBuffer(data, numSamples);
+
+	uint32 readPos, writePos;
+	{
+		Common::StackLock lock(_ringMutex);
+		readPos = _ringRead;
+		writePos = _ringWrite;
+	}
+
+	uint32 frames = MIN<uint32>(numSamples / 2, writePos - readPos);
+	uint32 offset = readPos & (_ringFrames - 1);
+	uint32 firstFrames = MIN<uint32>(frames, _ringFrames - offset);
+	memcpy(data, _ring + offset * 2, firstFrames * 4);
+	memcpy(data + firstFrames * 2, _ring, (frames - firstFrames) * 4);
+
+	if (frames * 2 < (uint32)numSamples) {
+		// Rendering didn't keep up, so fill the rest with silence
+		memset(data + frames * 2, 0, (numSamples - frames * 2) * 2);
+		++_underruns;
+		debug(5, "MT-32 render-ahead underrun of %u frames", (uint)(numSamples / 2 - frames));
+	}
+
+	Common::StackLock lock(_ringMutex);
+	_ringRead = readPos + frames;
+	return numSamples;
+}
+
 uint32 MidiDriver_MT32::property(int prop, uint32 param) {
 	switch (prop) {
 	case PROP_CHANNEL_MASK:
@@ -345,6 +345,26 @@ static const envelope_sinfunc envelope_sin[8] = {
     OPL3_EnvelopeCalcSin7
 };
 
+// With an attenuation of at least 0x180 every waveform's exponent lookup
+// shifts right by 12 or more, and exprom entries are below 0x800, so the
+// magnitude is always 0. Only the sign inversion of the waveform remains.
+#define OPL3_ENVELOPE_SILENT 0x180
+
+static Bit16s OPL3_EnvelopeCalcSilent(Bit8u wf, Bit16u phase)
+{
+    switch (wf)
+    {
+    case 0:
+    case 6:
+    case 7:
+        return (phase & 0x200) ? -1 : 0;
+    case 4:
+        return ((phase & 0x300) == 0x100) ? -1 : 0;
+    default:
+        return 0;
+    }
+}
+
 enum envelope_gen_num
 {
     envelope_gen_num_attack = 0,
@@ -379,6 +399,15 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
     Bit8u reset = 0;
     slot->eg_out = slot->eg_rout + (slot->reg_tl << 2)
                  + (slot->eg_ksl >> kslshift[slot->reg_ksl]) + *slot->trem;
+    // Released and fully attenuated: the rate calculation below cannot
+    // change anything but forcing the level to 0x1ff, so skip it
+    if (!slot->key && slot->eg_gen == envelope_gen_num_release
+        && (slot->eg_rout & 0x1f8) == 0x1f8)
+    {
+        slot->pg_reset = 0;
+        slot->eg_rout = 0x1ff;
+        return;
+    }
     if (slot->key && slot->eg_gen == envelope_gen_num_release)
     {
         reset = 1;
@@ -669,7 +698,14 @@ static void OPL3_SlotWriteE0(opl3_slot *slot, Bit8u data)
 
 static void OPL3_SlotGenerate(opl3_slot *slot)
 {
-    slot->out = envelope_sin[slot->reg_wf](slot->pg_phase_out + *slot->mod, slot->eg_out);
+    if ((Bit16u)slot->eg_out >= OPL3_ENVELOPE_SILENT)
+    {
+        slot->out = OPL3_EnvelopeCalcSilent(slot->reg_wf, slot->pg_phase_out + *slot->mod);
+    }
+    else
+    {
+        slot->out = envelope_sin[slot->reg_wf](slot->pg_phase_out + *slot->mod, slot->eg_out);
+    }
 }
 
 static void OPL3_SlotCalcFB(opl3_slot *slot)
@@ -1070,6 +1106,10 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
     chip->mixbuff[0] = 0;
     for (ii = 0; ii < 18; ii++)
     {
+        if (!chip->channel[ii].cha)
+        {
+            continue;
+        }
         accm = 0;
         for (jj = 0; jj < 4; jj++)
         {
@@ -1099,6 +1139,10 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
     chip->mixbuff[1] = 0;
     for (ii = 0; ii < 18; ii++)
     {
+        if (!chip->channel[ii].chb)
+        {
+            continue;
+        }
         accm = 0;
         for (jj = 0; jj < 4; jj++)
         {
@@ -1138,7 +1182,8 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
     chip->eg_add = 0;
     if (chip->eg_timer)
     {
-        while (shift < 36 && ((chip->eg_timer >> shift) & 1) == 0)
+        // Anything above 12 is treated the same, so stop looking there
+        while (shift < 13 && ((chip->eg_timer >> shift) & 1) == 0)
         {
             shift++;
         }
@@ -1375,10 +1420,33 @@ void OPL3_WriteRegBuffered(opl3_chip *chip, Bit16u reg, Bit8u v)
 void OPL3_GenerateStream(opl3_chip *chip, Bit16s *sndptr, Bit32u numsamples)
 {
     Bit32u i;
+    const Bit32s rateratio = chip->rateratio;
 
+    // Same as calling OPL3_GenerateResampled for every sample, with the
+    // interpolation skipped whenever it falls on a generated sample. At the
+    // native rate that is every output sample.
     for(i = 0; i < numsamples; i++)
     {
-        OPL3_GenerateResampled(chip, sndptr);
+        while (chip->samplecnt >= rateratio)
+        {
+            chip->oldsamples[0] = chip->samples[0];
+            chip->oldsamples[1] = chip->samples[1];
+            OPL3_Generate(chip, chip->samples);
+            chip->samplecnt -= rateratio;
+        }
+        if (chip->samplecnt == 0)
+        {
+            sndptr[0] = chip->oldsamples[0];
+            sndptr[1] = chip->oldsamples[1];
+        }
+        else
+        {
+            sndptr[0] = (Bit16s)((chip->oldsamples[0] * (rateratio - chip->samplecnt)
+                                + chip->samples[0] * chip->samplecnt) / rateratio);
+            sndptr[1] = (Bit16s)((chip->oldsamples[1] * (rateratio - chip->samplecnt)
+                                + chip->samples[1] * chip->samplecnt) / rateratio);
+        }
+        chip->samplecnt += 1 << RSM_FRAC;
         sndptr += 2;
     }
 }
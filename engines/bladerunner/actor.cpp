@@ -774,6 +774,10 @@ void Actor::tickCombat() {
 }
 
 bool Actor::draw(Common::Rect *screenRect) {
+	return draw(screenRect, _vm->_surfaceFront, _vm->_zbuffer->getData());
+}
+
+bool Actor::draw(Common::Rect *screenRect, Graphics::Surface &surface, uint16 *zbuffer) {
 	Vector3 drawPosition(_position.x, -_position.z, _position.y + 2.0);
 
 #if !BLADERUNNER_ORIGINAL_BUGS
@@ -790,7 +794,7 @@ bool Actor::draw(Common::Rect *screenRect) {
 		drawScale = 0.7f;
 	}
 
-	_vm->_sliceRenderer->drawInWorld(_animationId, _animationFrame, drawPosition, drawAngle, drawScale, _vm->_surfaceFront, _vm->_zbuffer->getData());
+	_vm->_sliceRenderer->drawInWorld(_animationId, _animationFrame, drawPosition, drawAngle, drawScale, surface, zbuffer);
 	_vm->_sliceRenderer->getScreenRectangle(screenRect, _animationId, _animationFrame, drawPosition, drawAngle, drawScale);
 
 	return !screenRect->isEmpty();
@@ -29,6 +29,10 @@
 #include "common/array.h"
 #include "common/rect.h"
 
+namespace Graphics {
+struct Surface;
+}
+
 namespace BladeRunner {
 
 class ActorClues;
@@ -136,6 +140,7 @@ public:
 	int getFacing() const;
 	int getAnimationMode() const;
 	int getAnimationId() const;
+	int getAnimationFrame() const { return _animationFrame; }
 
 	Vector3 getPosition() const { return _position; }
 
@@ -168,6 +173,7 @@ public:
 	bool tick(bool forceUpdate, Common::Rect *screenRect);
 	void tickCombat();
 	bool draw(Common::Rect *screenRect);
+	bool draw(Common::Rect *screenRect, Graphics::Surface &surface, uint16 *zbuffer);
 
 	int getSetId()  const;
 	void setSetId(int setId);
@@ -46,6 +46,15 @@ AudStream::AudStream(AudioCache *cache, int32 hash, int overrideFrequency) {
 	_cache->incRef(_hash);
 
 	init(_cache->findByHash(_hash));
+
+	if (_cache->isDecodedEnabled()) {
+		_samples = _cache->findDecoded(_hash, &_sampleCount);
+		if (_samples) {
+			_samplesShared = true;
+		} else {
+			decodeAll();
+		}
+	}
 }
 
 void AudStream::init(byte *data) {
@@ -61,9 +70,61 @@ void AudStream::init(byte *data) {
 
 	_deafBlockRemain = 0;
 	_p = _data + 12;
+
+	_samples = nullptr;
+	_sampleCount = 0;
+	_samplePos = 0;
+	_samplesShared = false;
+}
+
+uint32 AudStream::countSamples() const {
+	if (_compressionType != 99) {
+		return (_end - _data - 12) / 2;
+	}
+
+	// Every compressed byte decodes to two samples
+	uint32 count = 0;
+	for (const byte *p = _data + 12; _end - p >= 8; ) {
+		uint16 blockSize = READ_LE_UINT16(p);
+		count += 2 * blockSize;
+		p += 8 + blockSize;
+	}
+	return count;
+}
+
+void AudStream::decodeAll() {
+	uint32 sampleCount = countSamples();
+	if (sampleCount == 0 || !_cache->canStoreDecoded(sampleCount * 2)) {
+		return;
+	}
+
+	int16 *samples = (int16 *)malloc(sampleCount * 2);
+	if (samples == nullptr) {
+		return;
+	}
+
+	if (readBuffer(samples, sampleCount) != (int)sampleCount) {
+		// Not the expected size, so keep streaming from the compressed data
+		free(samples);
+		rewind();
+		return;
+	}
+	rewind();
+
+	_samples = samples;
+	_sampleCount = sampleCount;
+	_samplePos = 0;
+	_samplesShared = _cache->storeDecoded(_hash, samples, sampleCount);
 }
 
 AudStream::~AudStream() {
+	if (_samples) {
+		if (_samplesShared) {
+			_cache->decRefDecoded(_hash);
+		} else {
+			free(const_cast<int16 *>(_samples));
+		}
+	}
 	if (_cache) {
 		_cache->decRef(_hash);
 	}
@@ -72,7 +133,11 @@ AudStream::~AudStream() {
 int AudStream::readBuffer(int16 *buffer, const int numSamples) {
 	int samplesRead = 0;
 
-	if (_compressionType == 99) {
+	if (_samples) {
+		samplesRead = MIN<int>(numSamples, _sampleCount - _samplePos);
+		memcpy(buffer, _samples + _samplePos, samplesRead * 2);
+		_samplePos += samplesRead;
+	} else if (_compressionType == 99) {
 		assert(numSamples % 2 == 0);
 
 		while (samplesRead < numSamples) {
@@ -121,6 +186,7 @@ int AudStream::readBuffer(int16 *buffer, const int numSamples) {
 }
 
 bool AudStream::rewind() {
+	_samplePos = 0;
 	_p = _data + 12;
 	_decoder.setParameters(0, 0);
 	return true;
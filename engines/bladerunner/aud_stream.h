@@ -47,9 +47,17 @@ class AudStream : public Audio::RewindableAudioStream {
 	byte        _compressionType;
 	int         _overrideFrequency;
 
+	// Whole sound decoded up front, either shared through the cache or owned
+	const int16 *_samples;
+	uint32       _sampleCount;
+	uint32       _samplePos;
+	bool         _samplesShared;
+
 	ADPCMWestwoodDecoder _decoder;
 
 	void init(byte *data);
+	uint32 countSamples() const;
+	void decodeAll();
 
 public:
 	AudStream(byte *data, int overrideFrequency = -1);
@@ -59,7 +67,7 @@ public:
 	int readBuffer(int16 *buffer, const int numSamples);
 	bool isStereo() const { return false; }
 	int getRate() const { return _overrideFrequency > 0 ? _overrideFrequency : _frequency; };
-	bool endOfData() const { return _p == _end; }
+	bool endOfData() const { return _samples ? _samplePos == _sampleCount : _p == _end; }
 	bool rewind();
 	int getLength() const;
 };
@@ -22,19 +22,39 @@
 
 #include "bladerunner/audio_cache.h"
 
+#include "common/config-manager.h"
 #include "common/stream.h"
 
 namespace BladeRunner {
 
+// Memory for decoded sounds, can be set in KB by the "audio_cache_decoded_size" setting, 0 disabling it
+static const uint32 kDefaultDecodedSize = 4 * 1024 * 1024;
+static const int kMaxDecodedSizeKB = 1024 * 1024;
+
 AudioCache::AudioCache() :
 	_totalSize(0),
 	_maxSize(2457600),
-	_accessCounter(0) {}
+	_accessCounter(0),
+	_decodedSize(0),
+	_maxDecodedSize(kDefaultDecodedSize) {
+	if (ConfMan.hasKey("audio_cache_decoded_size")) {
+		int decodedSizeKB = ConfMan.getInt("audio_cache_decoded_size");
+		if (decodedSizeKB < 0 || decodedSizeKB > kMaxDecodedSizeKB) {
+			decodedSizeKB = CLIP(decodedSizeKB, 0, kMaxDecodedSizeKB);
+			warning("audio_cache_decoded_size must be between 0 and %d KB, using %d KB", kMaxDecodedSizeKB, decodedSizeKB);
+		}
+		_maxDecodedSize = decodedSizeKB * 1024;
+	}
+	resetStats();
+}
 
 AudioCache::~AudioCache() {
 	for (uint i = 0; i != _cacheItems.size(); ++i) {
 		free(_cacheItems[i].data);
 	}
+	for (uint i = 0; i != _decodedItems.size(); ++i) {
+		free(_decodedItems[i].samples);
+	}
 }
 
 bool AudioCache::canAllocate(uint32 size) const {
@@ -126,4 +146,94 @@ void AudioCache::decRef(int32 hash) {
 	assert(false && "AudioCache::decRef: hash not found");
 }
 
+bool AudioCache::canStoreDecoded(uint32 size) const {
+	// Long sounds like speech would push everything else out, so only keep
+	// sounds that take up at most a quarter of the budget
+	return size <= _maxDecodedSize / 4;
+}
+
+bool AudioCache::dropOldestDecoded() {
+	int oldest = -1;
+	for (uint i = 0; i != _decodedItems.size(); ++i) {
+		if (_decodedItems[i].refs == 0) {
+			if (oldest == -1 || _decodedItems[i].lastAccess < _decodedItems[oldest].lastAccess) {
+				oldest = i;
+			}
+		}
+	}
+
+	if (oldest == -1) {
+		return false;
+	}
+
+	free(_decodedItems[oldest].samples);
+	_decodedSize -= _decodedItems[oldest].sampleCount * 2;
+	_decodedItems.remove_at(oldest);
+	++_decodedEvictions;
+	return true;
+}
+
+const int16 *AudioCache::findDecoded(int32 hash, uint32 *sampleCount) {
+	Common::StackLock lock(_mutex);
+
+	for (uint i = 0; i != _decodedItems.size(); ++i) {
+		if (_decodedItems[i].hash == hash) {
+			_decodedItems[i].refs++;
+			_decodedItems[i].lastAccess = _accessCounter++;
+			*sampleCount = _decodedItems[i].sampleCount;
+			++_decodedHits;
+			return _decodedItems[i].samples;
+		}
+	}
+
+	++_decodedMisses;
+	return nullptr;
+}
+
+bool AudioCache::storeDecoded(int32 hash, int16 *samples, uint32 sampleCount) {
+	Common::StackLock lock(_mutex);
+
+	uint32 size = sampleCount * 2;
+	_bytesDecoded += size;
+
+	while (_maxDecodedSize - _decodedSize < size) {
+		if (!dropOldestDecoded()) {
+			// Everything left is playing, so the caller keeps its own copy
+			return false;
+		}
+	}
+
+	decodedItem item = {
+		hash,
+		1,
+		_accessCounter++,
+		samples,
+		sampleCount
+	};
+
+	_decodedItems.push_back(item);
+	_decodedSize += size;
+	return true;
+}
+
+void AudioCache::decRefDecoded(int32 hash) {
+	Common::StackLock lock(_mutex);
+
+	for (uint i = 0; i != _decodedItems.size(); ++i) {
+		if (_decodedItems[i].hash == hash) {
+			assert(_decodedItems[i].refs > 0);
+			_decodedItems[i].refs--;
+			return;
+		}
+	}
+	assert(false && "AudioCache::decRefDecoded: hash not found");
+}
+
+void AudioCache::resetStats() {
+	_decodedHits = 0;
+	_decodedMisses = 0;
+	_decodedEvictions = 0;
+	_bytesDecoded = 0;
+}
+
 } // End of namespace BladeRunner
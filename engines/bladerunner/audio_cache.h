@@ -40,13 +40,32 @@ class AudioCache {
 		uint32  size;
 	};
 
-	Common::Mutex            _mutex;
-	Common::Array<cacheItem> _cacheItems;
+	struct decodedItem {
+		int32   hash;
+		int     refs;
+		uint    lastAccess;
+		int16  *samples;
+		uint32  sampleCount;
+	};
+
+	Common::Mutex              _mutex;
+	Common::Array<cacheItem>   _cacheItems;
+	Common::Array<decodedItem> _decodedItems;
 
 	uint32 _totalSize;
 	uint32 _maxSize;
 	uint32 _accessCounter;
 
+	uint32 _decodedSize;
+	uint32 _maxDecodedSize;
+
+	uint32 _decodedHits;
+	uint32 _decodedMisses;
+	uint32 _decodedEvictions;
+	uint32 _bytesDecoded;
+
+	bool dropOldestDecoded();
+
 public:
 	AudioCache();
 	~AudioCache();
@@ -58,6 +77,22 @@ public:
 
 	void  incRef(int32 hash);
 	void  decRef(int32 hash);
+
+	// Decoded PCM tier, shared by all streams playing the same sound
+	bool         isDecodedEnabled() const { return _maxDecodedSize != 0; }
+	bool         canStoreDecoded(uint32 size) const;
+	const int16 *findDecoded(int32 hash, uint32 *sampleCount);
+	bool         storeDecoded(int32 hash, int16 *samples, uint32 sampleCount);
+	void         decRefDecoded(int32 hash);
+
+	uint32 getDecodedSize() const { return _decodedSize; }
+	uint32 getMaxDecodedSize() const { return _maxDecodedSize; }
+	uint32 getDecodedCount() const { return _decodedItems.size(); }
+	uint32 getDecodedHits() const { return _decodedHits; }
+	uint32 getDecodedMisses() const { return _decodedMisses; }
+	uint32 getDecodedEvictions() const { return _decodedEvictions; }
+	uint32 getBytesDecoded() const { return _bytesDecoded; }
+	void   resetStats();
 };
 
 } // End of namespace BladeRunner
@@ -1094,8 +1094,10 @@ void BladeRunnerEngine::gameTick() {
 			if (_actors[i]->tick(backgroundChanged, &screenRect)) {
 				_zbuffer->mark(screenRect);
 			}
+			_sliceAnimations->prefetchFrames(_actors[i]->getAnimationId(), _actors[i]->getAnimationFrame() + 1, SliceAnimations::kPrefetchFrameCount);
 		}
 	}
+	_sliceAnimations->tickPrefetch();
 
 	_items->tick();
 
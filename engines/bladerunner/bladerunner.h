@@ -39,6 +39,8 @@
 #define BLADERUNNER_DEBUG_CONSOLE     0
 #define BLADERUNNER_ORIGINAL_SETTINGS 0
 #define BLADERUNNER_ORIGINAL_BUGS     0
+// Keeps the old slice span loop and adds the slice_bench debugger command
+#define BLADERUNNER_DEBUG_SLICE_BENCH 0
 
 namespace Common {
 struct Event;
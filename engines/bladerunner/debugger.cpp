@@ -23,6 +23,7 @@
 #include "bladerunner/debugger.h"
 
 #include "bladerunner/actor.h"
+#include "bladerunner/audio_cache.h"
 #include "bladerunner/bladerunner.h"
 #include "bladerunner/boundingbox.h"
 #include "bladerunner/combat.h"
@@ -33,6 +34,7 @@
 #include "bladerunner/game_info.h"
 #include "bladerunner/light.h"
 #include "bladerunner/lights.h"
+#include "bladerunner/obstacles.h"
 #include "bladerunner/regions.h"
 #include "bladerunner/savefile.h"
 #include "bladerunner/scene.h"
@@ -41,6 +43,8 @@
 #include "bladerunner/item_pickup.h"
 #include "bladerunner/screen_effects.h"
 #include "bladerunner/settings.h"
+#include "bladerunner/slice_animations.h"
+#include "bladerunner/slice_renderer.h"
 #include "bladerunner/set.h"
 #include "bladerunner/set_effects.h"
 #include "bladerunner/text_resource.h"
@@ -65,6 +69,7 @@
 
 #include "common/debug.h"
 #include "common/str.h"
+#include "common/system.h"
 
 #include "graphics/surface.h"
 
@@ -133,6 +138,13 @@ Debugger::Debugger(BladeRunnerEngine *vm) : GUI::Debugger() {
 	registerCmd("item", WRAP_METHOD(Debugger, cmdItem));
 	registerCmd("region", WRAP_METHOD(Debugger, cmdRegion));
 	registerCmd("click", WRAP_METHOD(Debugger, cmdClick));
+	registerCmd("page_cache_stats", WRAP_METHOD(Debugger, cmdPageCacheStats));
+	registerCmd("vqa_bench", WRAP_METHOD(Debugger, cmdVqaBench));
+	registerCmd("path_bench", WRAP_METHOD(Debugger, cmdPathBench));
+#if BLADERUNNER_DEBUG_SLICE_BENCH
+	registerCmd("slice_bench", WRAP_METHOD(Debugger, cmdSliceBench));
+#endif
+	registerCmd("audio_cache_stats", WRAP_METHOD(Debugger, cmdAudioCacheStats));
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 	registerCmd("effect", WRAP_METHOD(Debugger, cmdEffect));
@@ -1780,6 +1792,324 @@ bool Debugger::cmdClick(int argc, const char **argv) {
 	return true;
 }
 
+/**
+* Show the slice animation page cache statistics
+*/
+bool Debugger::cmdPageCacheStats(int argc, const char **argv) {
+	SliceAnimations *sliceAnimations = _vm->_sliceAnimations;
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		sliceAnimations->resetStats();
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Show the slice animation page cache statistics\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	if (sliceAnimations->getPageBudget()) {
+		debugPrintf("Pages loaded: %u of %u\n", sliceAnimations->getPagesLoaded(), sliceAnimations->getPageBudget());
+	} else {
+		debugPrintf("Pages loaded: %u\n", sliceAnimations->getPagesLoaded());
+	}
+	debugPrintf("Pages waiting for prefetch: %u\n", sliceAnimations->getPrefetchQueueSize());
+	debugPrintf("Hits: %u, misses: %u, late loads: %u\n", sliceAnimations->getHits(), sliceAnimations->getMisses(), sliceAnimations->getLateLoads());
+	debugPrintf("Prefetched: %u, evicted: %u\n", sliceAnimations->getPrefetches(), sliceAnimations->getEvictions());
+	return true;
+}
+
+/**
+* Show the decoded sound cache statistics
+*/
+bool Debugger::cmdAudioCacheStats(int argc, const char **argv) {
+	AudioCache *audioCache = _vm->_audioCache;
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		audioCache->resetStats();
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Show the decoded sound cache statistics\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	if (!audioCache->isDecodedEnabled()) {
+		debugPrintf("Decoded sound cache is disabled\n");
+		return true;
+	}
+
+	debugPrintf("Decoded sounds: %u, %u of %u bytes\n", audioCache->getDecodedCount(), audioCache->getDecodedSize(), audioCache->getMaxDecodedSize());
+	debugPrintf("Hits: %u, misses: %u, evicted: %u\n", audioCache->getDecodedHits(), audioCache->getDecodedMisses(), audioCache->getDecodedEvictions());
+	debugPrintf("Bytes decoded: %u\n", audioCache->getBytesDecoded());
+	return true;
+}
+
+/**
+* Decode every frame of a VQA, or of the set VQAs of the current chapter, and show the time it took.
+* With "ahead", each frame is read ahead first, the way VQAPlayer does while waiting for it. The time of a pass
+* that only reads ahead is shown separately and left out of the time per frame.
+*/
+bool Debugger::cmdVqaBench(int argc, const char **argv) {
+	if (argc != 2 && !(argc == 3 && !scumm_stricmp(argv[2], "ahead"))) {
+		debugPrintf("Decode all frames of a VQA, or of all set VQAs of the current chapter, and show the time per frame\n");
+		debugPrintf("Usage: %s <name.VQA>|sets [ahead]\n", argv[0]);
+		return true;
+	}
+
+	bool readAhead = argc == 3;
+
+	Common::Array<Common::String> names;
+	if (!scumm_stricmp(argv[1], "sets")) {
+		// Same naming as Scene::open()
+		int resourceId = _vm->_chapters->currentResourceId();
+		for (uint i = 0; i < _vm->_gameInfo->getSceneNamesCount(); ++i) {
+			const Common::String &sceneName = _vm->_gameInfo->getSceneName(i);
+			if (resourceId <= 1) {
+				names.push_back(Common::String::format("%s.VQA", sceneName.c_str()));
+			} else {
+				names.push_back(Common::String::format("%s_%d.VQA", sceneName.c_str(), MIN(resourceId, 3)));
+			}
+		}
+	} else {
+		names.push_back(argv[1]);
+	}
+
+	Graphics::Surface surface;
+	surface.create(640, 480, screenPixelFormat());
+	ZBuffer zbuffer;
+	zbuffer.init(640, 480);
+
+	uint32 totalTime = 0;
+	uint32 totalAheadTime = 0;
+	int totalFrames = 0;
+
+	for (uint i = 0; i < names.size(); ++i) {
+		Common::SeekableReadStream *s = _vm->getResourceStream(names[i]);
+		if (!s) {
+			continue;
+		}
+
+		uint32 aheadTime = 0;
+		if (readAhead) {
+			VQADecoder *decoder = new VQADecoder();
+			if (decoder->loadStream(s)) {
+				uint32 startTime = g_system->getMillis();
+				for (int frame = 0; frame < decoder->numFrames(); ++frame) {
+					decoder->readAhead(frame, surface.format);
+				}
+				aheadTime = g_system->getMillis() - startTime;
+			}
+			delete decoder;
+			s->seek(0);
+		}
+
+		VQADecoder *decoder = new VQADecoder();
+		if (decoder->loadStream(s)) {
+			uint32 startTime = g_system->getMillis();
+			int frameCount = decoder->numFrames();
+			for (int frame = 0; frame < frameCount; ++frame) {
+				if (readAhead) {
+					decoder->readAhead(frame, surface.format);
+				}
+				decoder->readFrame(frame, kVQAReadAll);
+				decoder->decodeVideoFrame(&surface, frame);
+				decoder->decodeZBuffer(&zbuffer);
+				if (decoder->hasAudio()) {
+					delete decoder->decodeAudioFrame();
+				}
+			}
+			uint32 time = g_system->getMillis() - startTime;
+			time -= MIN(aheadTime, time);
+
+			if (readAhead) {
+				debugPrintf("%-12s %4d frames, %.2f ms per frame, %.2f ms read ahead\n", names[i].c_str(), frameCount, frameCount ? (float)time / frameCount : 0.0f, frameCount ? (float)aheadTime / frameCount : 0.0f);
+			} else {
+				debugPrintf("%-12s %4d frames, %.2f ms per frame\n", names[i].c_str(), frameCount, frameCount ? (float)time / frameCount : 0.0f);
+			}
+			totalTime += time;
+			totalAheadTime += aheadTime;
+			totalFrames += frameCount;
+		}
+		delete decoder;
+		delete s;
+	}
+
+	if (totalFrames) {
+		if (readAhead) {
+			debugPrintf("Total: %d frames, %.2f ms per frame, %.2f ms read ahead\n", totalFrames, (float)totalTime / totalFrames, (float)totalAheadTime / totalFrames);
+		} else {
+			debugPrintf("Total: %d frames, %.2f ms per frame\n", totalFrames, (float)totalTime / totalFrames);
+		}
+	}
+
+	surface.free();
+	return true;
+}
+
+/**
+* Time finding waypoints between random points of the current set's walkboxes, with and without
+* skipping obstacles by their bounds, and check that both ways find the same waypoints
+*/
+bool Debugger::cmdPathBench(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("Time the pathfinding between random points of the current set\n");
+		debugPrintf("Usage: %s [<count>]\n", argv[0]);
+		return true;
+	}
+
+	int count = argc == 2 ? atoi(argv[1]) : 200;
+	Set *set = _vm->_scene->_set;
+	Obstacles *obstacles = _vm->_obstacles;
+
+	if (count <= 0 || set->_walkboxCount == 0) {
+		debugPrintf("Nothing to do\n");
+		return true;
+	}
+
+	Common::RandomSource rnd("bladerunner_pathbench");
+	Common::Array<Vector3> points;
+	for (int i = 0; i < 2 * count; ++i) {
+		const Set::Walkbox &walkbox = set->_walkboxes[rnd.getRandomNumber(set->_walkboxCount - 1)];
+
+		float minX = walkbox.vertices[0].x;
+		float maxX = walkbox.vertices[0].x;
+		float minZ = walkbox.vertices[0].z;
+		float maxZ = walkbox.vertices[0].z;
+		for (int j = 1; j < walkbox.vertexCount; ++j) {
+			minX = MIN(minX, walkbox.vertices[j].x);
+			maxX = MAX(maxX, walkbox.vertices[j].x);
+			minZ = MIN(minZ, walkbox.vertices[j].z);
+			maxZ = MAX(maxZ, walkbox.vertices[j].z);
+		}
+
+		// Try a few points within the bounds of the walkbox to find one inside it
+		Vector3 point;
+		for (int tries = 0; tries < 16; ++tries) {
+			point.x = minX + (maxX - minX) * rnd.getRandomNumber(1000) / 1000.0f;
+			point.z = minZ + (maxZ - minZ) * rnd.getRandomNumber(1000) / 1000.0f;
+			if (Set::isXZInWalkbox(point.x, point.z, walkbox)) {
+				break;
+			}
+		}
+		point.y = walkbox.altitude;
+		points.push_back(point);
+	}
+
+	// The last path is saved with the game, so put it back afterwards
+	Vector2 savedPath[Obstacles::kVertexCount];
+	int savedPathSize = obstacles->_pathSize;
+	for (int i = 0; i < Obstacles::kVertexCount; ++i) {
+		savedPath[i] = obstacles->_path[i];
+	}
+
+	Common::Array<Vector3> next[2];
+	Common::Array<bool> found[2];
+	uint32 time[2];
+	for (int pass = 0; pass < 2; ++pass) {
+		obstacles->_useBounds = pass == 0;
+		next[pass].resize(count);
+		found[pass].resize(count);
+
+		uint32 startTime = g_system->getMillis();
+		for (int i = 0; i < count; ++i) {
+			found[pass][i] = obstacles->findNextWaypoint(points[2 * i], points[2 * i + 1], &next[pass][i]);
+		}
+		time[pass] = g_system->getMillis() - startTime;
+	}
+	obstacles->_useBounds = true;
+
+	obstacles->_pathSize = savedPathSize;
+	for (int i = 0; i < Obstacles::kVertexCount; ++i) {
+		obstacles->_path[i] = savedPath[i];
+	}
+
+	int mismatches = 0;
+	for (int i = 0; i < count; ++i) {
+		if (found[0][i] != found[1][i]
+		 || next[0][i].x != next[1][i].x
+		 || next[0][i].y != next[1][i].y
+		 || next[0][i].z != next[1][i].z
+		) {
+			++mismatches;
+		}
+	}
+
+	debugPrintf("%d paths: %u ms skipping obstacles by bounds, %u ms checking all obstacles\n", count, time[0], time[1]);
+	debugPrintf("%d paths found different waypoints\n", mismatches);
+	return true;
+}
+
+#if BLADERUNNER_DEBUG_SLICE_BENCH
+bool Debugger::cmdSliceBench(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("Time drawing the actors of the current set with the reference and the fast slice span loop\n");
+		debugPrintf("Usage: %s [<rounds>]\n", argv[0]);
+		return true;
+	}
+
+	int rounds = argc == 2 ? atoi(argv[1]) : 50;
+	int setId = _vm->_scene->getSetId();
+
+	Common::Array<Actor *> actors;
+	for (int i = 0, end = _vm->_gameInfo->getActorCount(); i != end; ++i) {
+		if (_vm->_actors[i]->getSetId() == setId) {
+			actors.push_back(_vm->_actors[i]);
+		}
+	}
+
+	if (rounds <= 0 || actors.empty()) {
+		debugPrintf("Nothing to do\n");
+		return true;
+	}
+
+	// Draw onto copies of the background and its z-buffer, so the screen is left alone
+	const Graphics::Surface &background = _vm->_surfaceBack;
+	Graphics::Surface surface;
+	surface.create(background.w, background.h, background.format);
+	const uint32 surfaceSize = background.pitch * background.h;
+	const uint32 zbufferSize = background.w * background.h;
+	uint16 *zbuffer = new uint16[zbufferSize];
+
+	SliceRenderer *sliceRenderer = _vm->_sliceRenderer;
+	sliceRenderer->setView(_vm->_view);
+
+	uint32 checksum[2];
+	uint32 time[2];
+	for (int pass = 0; pass < 2; ++pass) {
+		sliceRenderer->setFastSpans(pass == 1);
+
+		uint32 startTime = g_system->getMillis();
+		for (int i = 0; i < rounds; ++i) {
+			memcpy(surface.getPixels(), background.getPixels(), surfaceSize);
+			memcpy(zbuffer, _vm->_zbuffer->getBackgroundData(), zbufferSize * 2);
+			for (uint j = 0; j < actors.size(); ++j) {
+				Common::Rect screenRect;
+				actors[j]->draw(&screenRect, surface, zbuffer);
+			}
+		}
+		time[pass] = g_system->getMillis() - startTime;
+
+		// FNV-1a over the drawn pixels and depths
+		checksum[pass] = 2166136261U;
+		const byte *pixels = (const byte *)surface.getPixels();
+		for (uint32 i = 0; i < surfaceSize; ++i) {
+			checksum[pass] = (checksum[pass] ^ pixels[i]) * 16777619U;
+		}
+		for (uint32 i = 0; i < zbufferSize; ++i) {
+			checksum[pass] = (checksum[pass] ^ zbuffer[i]) * 16777619U;
+		}
+	}
+	sliceRenderer->setFastSpans(true);
+
+	delete[] zbuffer;
+	surface.free();
+
+	debugPrintf("%u actors, %d rounds: %u ms reference, %u ms fast\n", actors.size(), rounds, time[0], time[1]);
+	debugPrintf("Checksums %08x and %08x %s\n", checksum[0], checksum[1], checksum[0] == checksum[1] ? "match" : "DIFFER");
+	return true;
+}
+#endif // BLADERUNNER_DEBUG_SLICE_BENCH
+
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 bool Debugger::cmdEffect(int argc, const char **argv) {
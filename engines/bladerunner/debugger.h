@@ -23,6 +23,7 @@
 #ifndef BLADERUNNER_DEBUGGER_H
 #define BLADERUNNER_DEBUGGER_H
 
+#include "bladerunner/bladerunner.h"
 #include "bladerunner/vector.h"
 
 #include "gui/debugger.h"
@@ -113,6 +114,13 @@ public:
 	bool cmdItem(int argc, const char **argv);
 	bool cmdRegion(int argc, const char **argv);
 	bool cmdClick(int argc, const char **argv);
+	bool cmdPageCacheStats(int argc, const char **argv);
+	bool cmdVqaBench(int argc, const char **argv);
+	bool cmdPathBench(int argc, const char **argv);
+#if BLADERUNNER_DEBUG_SLICE_BENCH
+	bool cmdSliceBench(int argc, const char **argv);
+#endif
+	bool cmdAudioCacheStats(int argc, const char **argv);
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 	bool cmdEffect(int argc, const char **argv);
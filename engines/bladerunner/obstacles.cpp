@@ -44,6 +44,7 @@ Obstacles::Obstacles(BladeRunnerEngine *vm) {
 	_polygons       = new Polygon[kPolygonCount];
 	_polygonsBackup = new Polygon[kPolygonCount];
 	_path           = new Vector2[kVertexCount];
+	_useBounds      = true;
 	clear();
 }
 
@@ -325,6 +326,22 @@ restart:
 	}
 }
 
+// The bounds of a polygon contain all its vertices, so no line can cross one of its edges
+// without getting into them. The margin keeps rounding from making a difference.
+bool Obstacles::lineNearPolygon(Vector2 from, Vector2 to, const Polygon &poly) const {
+	const float margin = 1.0f;
+
+	return !_useBounds
+	    || !(MAX(from.x, to.x) < poly.rect.x0 - margin
+	      || MIN(from.x, to.x) > poly.rect.x1 + margin
+	      || MAX(from.y, to.y) < poly.rect.y0 - margin
+	      || MIN(from.y, to.y) > poly.rect.y1 + margin);
+}
+
+bool Obstacles::pointNearPolygon(float x, float z, const Polygon &poly) const {
+	return lineNearPolygon(Vector2(x, z), Vector2(x, z), poly);
+}
+
 int Obstacles::findEmptyPolygon() const {
 	for (int i = 0; i < kPolygonCount; i++) {
 		if (!_polygons[i].isPresent) {
@@ -370,7 +387,7 @@ bool Obstacles::findNextWaypoint(const Vector3 &from, const Vector3 &to, Vector3
 
 	for (int i = 0; i != kPolygonCount; ++i) {
 		Polygon &poly = _polygons[i];
-		if (!poly.isPresent || polygonVisited[i]) {
+		if (!poly.isPresent || polygonVisited[i] || !lineNearPolygon(from.xz(), to.xz(), poly)) {
 			continue;
 		}
 
@@ -562,7 +579,7 @@ bool Obstacles::findPolygonVerticeByXZWithinTolerance(float x, float z, int *pol
 //	for (int i = 0; i != kPolygonCount; ++i) {
 	for (int countUp = 0, i = startSearchFromPolygonIdx; countUp != kPolygonCount; ++countUp, ++i) {
 		i = i  % kPolygonCount;	// we want to circle around to go through all polygons
-		if (!_polygons[i].isPresent || _polygons[i].verticeCount == 0) {
+		if (!_polygons[i].isPresent || _polygons[i].verticeCount == 0 || !pointNearPolygon(x, z, _polygons[i])) {
 			continue;
 		}
 
@@ -736,7 +753,7 @@ bool Obstacles::findFarthestAvailablePathVertex(Vector2 *path, int pathSize, Vec
 		for (int currentPolygonIdx = 0; currentPolygonIdx < kPolygonCount && pathVertexAvailable; ++currentPolygonIdx) {
 			Polygon *polygon = &_polygons[currentPolygonIdx];
 
-			if (!polygon->isPresent || polygon->verticeCount == 0) {
+			if (!polygon->isPresent || polygon->verticeCount == 0 || !lineNearPolygon(Vector2(start.x, start.z), path[pathVertexIdx], *polygon)) {
 				continue;
 			}
 
@@ -33,6 +33,8 @@ class SaveFileReadStream;
 class SaveFileWriteStream;
 
 class Obstacles {
+	friend class Debugger;
+
 	static const int kVertexCount        = 150;
 	static const int kPolygonCount       =  50;
 	static const int kPolygonVertexCount = 160;
@@ -70,11 +72,17 @@ class Obstacles {
 	int      _count;
 	bool     _backup;
 
+	// Skip the polygons whose bounds a line or point is clear of, set to false to compare against checking everything
+	bool     _useBounds;
+
 	static bool lineLineIntersection(LineSegment a, LineSegment b, Vector2 *intersectionPoint);
 	static bool linePolygonIntersection(LineSegment lineA, VertexType lineAType, Polygon *polyB, Vector2 *intersectionPoint, int *intersectionIndex, int pathLengthSinceLastIntersection);
 
 	bool mergePolygons(Polygon &polyA, Polygon &PolyB);
 
+	bool lineNearPolygon(Vector2 from, Vector2 to, const Polygon &poly) const;
+	bool pointNearPolygon(float x, float z, const Polygon &poly) const;
+
 public:
 	Obstacles(BladeRunnerEngine *vm);
 	~Obstacles();
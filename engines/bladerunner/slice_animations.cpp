@@ -25,12 +25,21 @@
 #include "bladerunner/bladerunner.h"
 #include "bladerunner/time.h"
 
+#include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/system.h"
 
 namespace BladeRunner {
 
+// Memory for loaded pages, can be set in KB by the "frames_cache_size" setting, 0 meaning no limit
+static const uint32 kDefaultCacheSize = 64 * 1024 * 1024;
+// Largest accepted "frames_cache_size", in KB
+static const int kMaxCacheSizeKB = 1024 * 1024;
+
+// Prefetching is spread over ticks, so that it doesn't cause stutter itself
+static const int kPrefetchPagesPerTick = 2;
+
 bool SliceAnimations::open(const Common::String &name) {
 	Common::File file;
 	if (!file.open(_vm->getResourceStream(name), name))
@@ -44,6 +53,20 @@ bool SliceAnimations::open(const Common::String &name) {
 	if (_timestamp != 0x3457b6f6) // Timestamp: Wed, 29 Oct 1997 22:21:42 GMT
 		return false;
 
+	uint32 cacheSize = kDefaultCacheSize;
+	if (ConfMan.hasKey("frames_cache_size")) {
+		int cacheSizeKB = ConfMan.getInt("frames_cache_size");
+		if (cacheSizeKB < 0 || cacheSizeKB > kMaxCacheSizeKB) {
+			cacheSizeKB = CLIP(cacheSizeKB, 0, kMaxCacheSizeKB);
+			warning("frames_cache_size must be between 0 and %d KB, using %d KB", kMaxCacheSizeKB, cacheSizeKB);
+		}
+		cacheSize = cacheSizeKB * 1024;
+	}
+	_pageBudget = _pageSize ? cacheSize / _pageSize : 0;
+	if (cacheSize && _pageBudget < 16) {
+		_pageBudget = 16;
+	}
+
 	_palettes.resize(_paletteCount);
 
 	Graphics::PixelFormat screenFormat = screenPixelFormat();
@@ -220,8 +243,6 @@ void *SliceAnimations::PageFile::loadPage(uint32 pageNumber) {
 
 	uint32 pageSize = _sliceAnimations->_pageSize;
 
-	// TODO: Retire oldest pages if we exceed some memory limit
-
 	void *data = malloc(pageSize);
 	_files[_pageOffsetsFileIdx[pageNumber]].seek(_pageOffsets[pageNumber], SEEK_SET);
 	uint32 r = _files[_pageOffsetsFileIdx[pageNumber]].read(data, pageSize);
@@ -259,15 +280,17 @@ void *SliceAnimations::getFramePtr(uint32 animation, uint32 frame) {
 	uint32 pageOffset  = frameOffset % _pageSize;
 
 	if (_pages[page]._data == nullptr) {                          // if not cached already
-		_pages[page]._data = _coreAnimPageFile.loadPage(page);    // look in COREANIM first
-
-		if (_pages[page]._data == nullptr) {                      // if not in COREAMIM
-			_pages[page]._data = _framesPageFile.loadPage(page);  // Look in CDFRAMES or HDFRAMES loaded data
+		if (_pages[page]._queued) {
+			++_lateLoads;
+		} else {
+			++_misses;
+		}
 
-			if (_pages[page]._data == nullptr) {
-				error("Unable to locate page %d for animation %d frame %d", page, animation, frame);
-			}
+		if (!loadPage(page)) {
+			error("Unable to locate page %d for animation %d frame %d", page, animation, frame);
 		}
+	} else {
+		++_hits;
 	}
 
 	_pages[page]._lastAccess = _vm->_time->currentSystem();
@@ -275,6 +298,104 @@ void *SliceAnimations::getFramePtr(uint32 animation, uint32 frame) {
 	return (byte *)_pages[page]._data + pageOffset;
 }
 
+uint32 SliceAnimations::getPageNumber(uint32 animation, uint32 frame) const {
+	return (_animations[animation].offset + frame * _animations[animation].frameSize) / _pageSize;
+}
+
+bool SliceAnimations::loadPage(uint32 page) {
+	void *data = _coreAnimPageFile.loadPage(page); // look in COREANIM first
+
+	if (data == nullptr) {                         // if not in COREAMIM
+		data = _framesPageFile.loadPage(page);     // Look in CDFRAMES or HDFRAMES loaded data
+
+		if (data == nullptr) {
+			return false;
+		}
+	}
+
+	_pages[page]._data = data;
+	_pages[page]._lastAccess = _vm->_time->currentSystem();
+	_pages[page]._queued = false;
+	++_pagesLoaded;
+
+	while (_pageBudget && _pagesLoaded > _pageBudget) {
+		evictPage(page);
+	}
+
+	return true;
+}
+
+void SliceAnimations::evictPage(uint32 keepPage) {
+	// Frame pointers are only held while drawing a single frame, so any page but the one
+	// just loaded can go
+	int oldest = -1;
+	for (uint32 i = 0; i != _pages.size(); ++i) {
+		if (_pages[i]._data != nullptr && i != keepPage && (oldest < 0 || _pages[i]._lastAccess < _pages[oldest]._lastAccess)) {
+			oldest = i;
+		}
+	}
+
+	if (oldest < 0) {
+		// Nothing else is loaded, so stay over the budget
+		_pageBudget = _pagesLoaded;
+		return;
+	}
+
+	free(_pages[oldest]._data);
+	_pages[oldest]._data = nullptr;
+	--_pagesLoaded;
+	++_evictions;
+}
+
+void SliceAnimations::prefetchFrames(int animation, int frame, int frameCount) {
+	if (animation < 0 || animation >= (int)_animations.size() || _animations[animation].frameCount == 0) {
+		return;
+	}
+
+	uint32 animationFrameCount = _animations[animation].frameCount;
+	uint32 lastPage = _pageCount;
+	for (int i = 0; i < frameCount; ++i) {
+		// Looping animations continue with their first frame
+		uint32 page = getPageNumber(animation, (uint32)(MAX(frame, 0) + i) % animationFrameCount);
+		if (page == lastPage || page >= _pageCount) {
+			continue;
+		}
+		lastPage = page;
+
+		if (_pages[page]._data == nullptr && !_pages[page]._queued) {
+			_pages[page]._queued = true;
+			_prefetchQueue.push(page);
+		}
+	}
+}
+
+void SliceAnimations::tickPrefetch() {
+	int loaded = 0;
+	while (loaded < kPrefetchPagesPerTick && !_prefetchQueue.empty()) {
+		uint32 page = _prefetchQueue.pop();
+
+		// Already loaded on demand, or queued more than once
+		if (!_pages[page]._queued) {
+			continue;
+		}
+
+		// Pages on another CD can't be loaded, but neither will they be used
+		_pages[page]._queued = false;
+		if (_pages[page]._data == nullptr && loadPage(page)) {
+			++_prefetches;
+			++loaded;
+		}
+	}
+}
+
+void SliceAnimations::resetStats() {
+	_hits       = 0;
+	_misses     = 0;
+	_lateLoads  = 0;
+	_prefetches = 0;
+	_evictions  = 0;
+}
+
 Vector3 SliceAnimations::getPositionChange(int animation) const {
 	return _animations[animation].positionChange;
 }
@@ -25,6 +25,7 @@
 
 #include "common/array.h"
 #include "common/file.h"
+#include "common/queue.h"
 #include "common/str.h"
 #include "common/types.h"
 
@@ -59,8 +60,9 @@ class SliceAnimations {
 	struct Page {
 		void   *_data;
 		uint32 _lastAccess;
+		bool   _queued;
 
-		Page() : _data(nullptr), _lastAccess(0) {}
+		Page() : _data(nullptr), _lastAccess(0), _queued(false) {}
 	};
 
 	struct PageFile {
@@ -91,6 +93,18 @@ class SliceAnimations {
 	PageFile _coreAnimPageFile;
 	PageFile _framesPageFile;
 
+	uint32 _pageBudget;
+	uint32 _pagesLoaded;
+
+	// Pages of upcoming frames, loaded a few at a time by tickPrefetch()
+	Common::Queue<uint32> _prefetchQueue;
+
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _lateLoads;
+	uint32 _prefetches;
+	uint32 _evictions;
+
 public:
 	SliceAnimations(BladeRunnerEngine *vm)
 		: _vm(vm)
@@ -99,7 +113,14 @@ public:
 		, _timestamp(0)
 		, _pageSize(0)
 		, _pageCount(0)
-		, _paletteCount(0) {}
+		, _paletteCount(0)
+		, _pageBudget(0)
+		, _pagesLoaded(0)
+		, _hits(0)
+		, _misses(0)
+		, _lateLoads(0)
+		, _prefetches(0)
+		, _evictions(0) {}
 	~SliceAnimations();
 
 	bool open(const Common::String &name);
@@ -115,6 +136,27 @@ public:
 
 	Vector3 getPositionChange(int animation) const;
 	float   getFacingChange(int animation) const;
+
+	// How many of an actor's upcoming frames get prefetched while it is animating
+	static const int kPrefetchFrameCount = 8;
+
+	void prefetchFrames(int animation, int frame, int frameCount);
+	void tickPrefetch();
+
+	uint32 getPageBudget() const { return _pageBudget; }
+	uint32 getPagesLoaded() const { return _pagesLoaded; }
+	uint32 getPrefetchQueueSize() const { return _prefetchQueue.size(); }
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	uint32 getLateLoads() const { return _lateLoads; }
+	uint32 getPrefetches() const { return _prefetches; }
+	uint32 getEvictions() const { return _evictions; }
+	void resetStats();
+
+private:
+	uint32 getPageNumber(uint32 animation, uint32 frame) const;
+	bool   loadPage(uint32 page);
+	void   evictPage(uint32 keepPage);
 };
 
 } // End of namespace BladeRunner
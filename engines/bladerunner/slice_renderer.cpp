@@ -46,6 +46,10 @@ SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
 	_facing    = 0.0f;
 	_scale     = 0.0f;
 
+#if BLADERUNNER_DEBUG_SLICE_BENCH
+	_fastSpans = true;
+#endif
+
 	_screenEffects = nullptr;
 	_view          = nullptr;
 	_lights        = nullptr;
@@ -542,6 +546,105 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 		return;
 	}
 
+#if BLADERUNNER_DEBUG_SLICE_BENCH
+	if (!_fastSpans) {
+		drawSliceReference(slice, advanced, y, surface, zbufferLine);
+		return;
+	}
+#endif
+
+	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
+
+	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
+
+	uint32 polyOffset = READ_LE_UINT32(p);
+
+	p = (byte *)_sliceFramePtr + polyOffset;
+
+	uint32 polyCount = READ_LE_UINT32(p);
+	p += 4;
+
+	byte *linePtr = (byte *)surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+	int bytesPerPixel = surface.format.bytesPerPixel;
+	int maxX = surface.w - 1;
+
+	// Lit colors of the palette entries on this line, valid where no screen effect adds to them
+	uint32 litColors[256];
+	uint32 litColorsValid[8] = { 0 };
+
+	while (polyCount--) {
+		uint32 vertexCount = READ_LE_UINT32(p);
+		p += 4;
+
+		if (vertexCount == 0)
+			continue;
+
+		uint32 lastVertex = vertexCount - 1;
+		int lastVertexX = MAX((_m11lookup[p[3 * lastVertex]] + _m12lookup[p[3 * lastVertex + 1]] + _m13) / 65536, 0);
+
+		int previousVertexX = lastVertexX;
+
+		while (vertexCount--) {
+			int vertexX = CLIP((_m11lookup[p[0]] + _m12lookup[p[1]] + _m13) / 65536, 0, 640);
+
+			if (vertexX > previousVertexX) {
+				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + _m23) / 64;
+
+				// Skip the hidden start of the span, so that fully hidden spans don't get lit at all
+				int x = previousVertexX;
+				if (vertexZ >= 0 && vertexZ < 65536) {
+					while (x != vertexX && vertexZ >= zbufferLine[x]) {
+						++x;
+					}
+				} else {
+					x = vertexX;
+				}
+
+				if (x != vertexX) {
+					uint8 colorIndex = p[2];
+					uint32 outColor = palette.value[colorIndex];
+					if (advanced) {
+						Color256 aescColor = { 0, 0, 0 };
+						_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
+
+						bool cacheable = aescColor.r == 0 && aescColor.g == 0 && aescColor.b == 0;
+						uint32 validBit = 1 << (colorIndex & 31);
+						if (cacheable && (litColorsValid[colorIndex >> 5] & validBit)) {
+							outColor = litColors[colorIndex];
+						} else {
+							Color256 color = palette.color[colorIndex];
+							color.r = ((int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536) + aescColor.r;
+							color.g = ((int)(_setEffectColor.g + _lightsColor.g * color.g) / 65536) + aescColor.g;
+							color.b = ((int)(_setEffectColor.b + _lightsColor.b * color.b) / 65536) + aescColor.b;
+
+							int bladeToScummVmConstant = 256 / 32;
+							outColor = _pixelFormat.RGBToColor(CLIP(color.r * bladeToScummVmConstant, 0, 255), CLIP(color.g * bladeToScummVmConstant, 0, 255), CLIP(color.b * bladeToScummVmConstant, 0, 255));
+
+							if (cacheable) {
+								litColors[colorIndex] = outColor;
+								litColorsValid[colorIndex >> 5] |= validBit;
+							}
+						}
+					}
+
+					for (; x != vertexX; ++x) {
+						if (vertexZ < zbufferLine[x]) {
+							zbufferLine[x] = (uint16)vertexZ;
+							drawPixel(surface, linePtr + MIN(x, maxX) * bytesPerPixel, outColor);
+						}
+					}
+				}
+			}
+			p += 3;
+			previousVertexX = vertexX;
+		}
+	}
+}
+
+#if BLADERUNNER_DEBUG_SLICE_BENCH
+// The span loop as it was before drawSlice() skipped hidden spans and cached
+// lit colors, kept to check that the output is unchanged (see slice_bench)
+void SliceRenderer::drawSliceReference(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine) {
 	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
 
 	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
@@ -601,6 +704,7 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 		}
 	}
 }
+#endif // BLADERUNNER_DEBUG_SLICE_BENCH
 
 void SliceRenderer::drawShadowInWorld(int transparency, Graphics::Surface &surface, uint16 *zbuffer) {
 	Matrix4x3 mOffset(
@@ -744,10 +848,7 @@ void SliceRenderer::drawShadowPolygon(int transparency, Graphics::Surface &surfa
 }
 
 void SliceRenderer::preload(int animationId) {
-	int frameCount = _vm->_sliceAnimations->getFrameCount(animationId);
-	for (int i = 0; i < frameCount; ++i) {
-		_vm->_sliceAnimations->getFramePtr(animationId, i);
-	}
+	_vm->_sliceAnimations->prefetchFrames(animationId, 0, _vm->_sliceAnimations->getFrameCount(animationId));
 }
 
 void SliceRenderer::disableShadows(int animationsIdsList[], int listSize) {
@@ -23,6 +23,7 @@
 #ifndef BLADERUNNER_SLICE_RENDERER_H
 #define BLADERUNNER_SLICE_RENDERER_H
 
+#include "bladerunner/bladerunner.h"
 #include "bladerunner/color.h"
 #include "bladerunner/vector.h"
 #include "bladerunner/view.h"
@@ -91,6 +92,10 @@ class SliceRenderer {
 
 	Graphics::PixelFormat _pixelFormat;
 
+#if BLADERUNNER_DEBUG_SLICE_BENCH
+	bool _fastSpans;
+#endif
+
 public:
 	SliceRenderer(BladeRunnerEngine *vm);
 	~SliceRenderer();
@@ -109,12 +114,20 @@ public:
 
 	void disableShadows(int *animationsIdsList, int listSize);
 
+#if BLADERUNNER_DEBUG_SLICE_BENCH
+	bool getFastSpans() const { return _fastSpans; }
+	void setFastSpans(bool fastSpans) { _fastSpans = fastSpans; }
+#endif
+
 private:
 	void calculateBoundingRect();
 	Matrix3x2 calculateFacingRotationMatrix();
 	void loadFrame(int animation, int frame);
 
 	void drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine);
+#if BLADERUNNER_DEBUG_SLICE_BENCH
+	void drawSliceReference(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine);
+#endif
 	void drawShadowInWorld(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 	void drawShadowPolygon(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 };
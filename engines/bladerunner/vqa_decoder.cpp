@@ -137,11 +137,23 @@ VQADecoder::VQADecoder() {
 	_header.unk5         = 0;
 	_readingFrame        = -1;
 	_decodingFrame       = -1;
+	_readAheadNext       = 0;
+
+	for (int i = 0; i != kReadAheadPackets; ++i) {
+		_readAhead[i].frame    = -1;
+		_readAhead[i].size     = 0;
+		_readAhead[i].capacity = 0;
+		_readAhead[i].data     = nullptr;
+	}
 }
 
 VQADecoder::~VQADecoder() {
 	for (uint i = 0; i < _codebooks.size(); ++i) {
 		delete[] _codebooks[i].data;
+		delete[] _codebooks[i].colors;
+	}
+	for (int i = 0; i != kReadAheadPackets; ++i) {
+		delete[] _readAhead[i].data;
 	}
 	delete _audioTrack;
 	delete _videoTrack;
@@ -263,13 +275,76 @@ void VQADecoder::readFrame(int frame, uint readFlags) {
 		error("VQADecoder::readFrame(): frame %d out of bounds, frame count is %d", frame, numFrames());
 	}
 
+	_readingFrame = frame;
+
+	for (int i = 0; i != kReadAheadPackets; ++i) {
+		if (_readAhead[i].frame == frame) {
+			Common::SeekableReadStream *s = _s;
+			Common::MemoryReadStream packetStream(_readAhead[i].data, _readAhead[i].size);
+			_s = &packetStream;
+			readPacket(readFlags);
+			_s = s;
+			return;
+		}
+	}
+
 	uint32 frameOffset = 2 * (_frameInfo[frame] & 0x0FFFFFFF);
 	_s->seek(frameOffset);
 
-	_readingFrame = frame;
 	readPacket(readFlags);
 }
 
+void VQADecoder::readAhead(int frame, const Graphics::PixelFormat &format) {
+	if (frame < 0 || frame >= numFrames()) {
+		return;
+	}
+
+	for (int i = 0; i != kReadAheadPackets; ++i) {
+		if (_readAhead[i].frame == frame) {
+			return;
+		}
+	}
+
+	// A frame's chunks run up to where the next frame begins
+	uint32 begin = 2 * (_frameInfo[frame] & 0x0FFFFFFF);
+	uint32 end   = frame + 1 < numFrames() ? 2 * (_frameInfo[frame + 1] & 0x0FFFFFFF) : (uint32)_s->size();
+	if (end <= begin || end > (uint32)_s->size()) {
+		return;
+	}
+
+	ReadAheadPacket &packet = _readAhead[_readAheadNext];
+	_readAheadNext = (_readAheadNext + 1) % kReadAheadPackets;
+
+	uint32 size = end - begin;
+	if (size > packet.capacity) {
+		delete[] packet.data;
+		packet.data = new uint8[size];
+		packet.capacity = size;
+	}
+
+	_s->seek(begin);
+	if (_s->read(packet.data, size) != size) {
+		packet.frame = -1;
+		return;
+	}
+	packet.frame = frame;
+	packet.size  = size;
+
+	// Decompressing and converting a new codebook is the most expensive part
+	// of a frame apart from drawing it, so do that now as well
+	CodebookInfo &codebookInfo = codebookInfoForFrame(frame);
+	if (!codebookInfo.data) {
+		readFrame(codebookInfo.frame, kVQAReadCodebook);
+	}
+	_videoTrack->convertCodebook(codebookInfo, format);
+}
+
+void VQADecoder::discardReadAhead() {
+	for (int i = 0; i != kReadAheadPackets; ++i) {
+		_readAhead[i].frame = -1;
+	}
+}
+
 bool VQADecoder::readVQHD(Common::SeekableReadStream *s, uint32 size) {
 	if (size != 42)
 		return false;
@@ -467,6 +542,7 @@ bool VQADecoder::readCINF(Common::SeekableReadStream *s, uint32 size) {
 		_codebooks[i].frame = s->readUint16LE();
 		_codebooks[i].size  = s->readUint32LE();
 		_codebooks[i].data  = nullptr;
+		_codebooks[i].colors = nullptr;
 
 		// debug("Codebook %2d: %4d %8d", i, _codebooks[i].frame, _codebooks[i].size);
 
@@ -595,8 +671,9 @@ VQADecoder::VQAVideoTrack::VQAVideoTrack(VQADecoder *vqaDecoder) {
 	_maxCBFZSize = header->maxCBFZSize;
 	_maxZBUFChunkSize = vqaDecoder->_maxZBUFChunkSize;
 
-	_codebook = nullptr;
-	_cbfz     = nullptr;
+	_codebook       = nullptr;
+	_codebookColors = nullptr;
+	_cbfz           = nullptr;
 
 	_vpointerSize = 0;
 	_vpointer = nullptr;
@@ -819,35 +896,54 @@ bool VQADecoder::VQAVideoTrack::readVPTR(Common::SeekableReadStream *s, uint32 s
 
 void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha) {
 	const uint8 *const block_src = &_codebook[2 * srcBlock * _blockW * _blockH];
+	const uint32 *const block_colors = &_codebookColors[srcBlock * _blockW * _blockH];
 
 	int blocks_per_line = _width / _blockW;
+	int bytesPerPixel = surface->format.bytesPerPixel;
 
 	for (int i = 0; i < count; ++i) {
 		uint32 dst_x = (dstBlock + i) % blocks_per_line * _blockW + _offsetX;
 		uint32 dst_y = (dstBlock + i) / blocks_per_line * _blockH + _offsetY;
 
 		const uint8 *src_p = block_src;
+		const uint32 *color_p = block_colors;
 
 		for (int y = 0; y != _blockH; ++y) {
-			for (int x = 0; x != _blockW; ++x) {
-				uint16 vqaColor = READ_LE_UINT16(src_p);
-				src_p += 2;
+			// clip is too slow and it is not needed
+			byte *dstPtr = (byte *)surface->getBasePtr(dst_x, dst_y + y);
 
-				uint8 a, r, g, b;
-				getGameDataColor(vqaColor, a, r, g, b);
-
-				if (!(alpha && a)) {
-					// clip is too slow and it is not needed
-					// void* dstPtr = surface->getBasePtr(CLIP(dst_x + x, (uint32)0, (uint32)(surface->w - 1)), CLIP(dst_y + y, (uint32)0, (uint32)(surface->h - 1)));
-					void* dstPtr = surface->getBasePtr(dst_x + x, dst_y + y);
+			for (int x = 0; x != _blockW; ++x) {
+				// The alpha is the top bit of the little endian codebook entry
+				if (!(alpha && (src_p[1] & 0x80))) {
 					// Ignore the alpha in the output as it is inversed in the input
-					drawPixel(*surface, dstPtr, surface->format.RGBToColor(r, g, b));
+					drawPixel(*surface, dstPtr, *color_p);
 				}
+				src_p += 2;
+				++color_p;
+				dstPtr += bytesPerPixel;
 			}
 		}
 	}
 }
 
+void VQADecoder::VQAVideoTrack::convertCodebook(CodebookInfo &codebookInfo, const Graphics::PixelFormat &format) {
+	// Convert the codebook once rather than every pixel of every frame drawn from it
+	if (!codebookInfo.data || (codebookInfo.colors && codebookInfo.colorsFormat == format)) {
+		return;
+	}
+
+	uint32 codebookEntries = _maxBlocks * _blockW * _blockH;
+	if (!codebookInfo.colors) {
+		codebookInfo.colors = new uint32[codebookEntries];
+	}
+	for (uint32 i = 0; i != codebookEntries; ++i) {
+		uint8 a, r, g, b;
+		getGameDataColor(READ_LE_UINT16(codebookInfo.data + 2 * i), a, r, g, b);
+		codebookInfo.colors[i] = format.RGBToColor(r, g, b);
+	}
+	codebookInfo.colorsFormat = format;
+}
+
 bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 	CodebookInfo &codebookInfo = _vqaDecoder->codebookInfoForFrame(_vqaDecoder->_decodingFrame);
 
@@ -859,6 +955,9 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 	if (!_codebook || !_vpointer)
 		return false;
 
+	convertCodebook(codebookInfo, surface->format);
+	_codebookColors = codebookInfo.colors;
+
 	uint8 *src = _vpointer;
 	uint8 *end = _vpointer + _vpointerSize;
 
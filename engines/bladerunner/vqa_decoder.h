@@ -63,6 +63,9 @@ public:
 
 	void readFrame(int frame, uint readFlags = kVQAReadAll);
 
+	void readAhead(int frame, const Graphics::PixelFormat &format);
+	void discardReadAhead();
+
 	void                        decodeVideoFrame(Graphics::Surface *surface, int frame, bool forceDraw = false);
 	void                        decodeZBuffer(ZBuffer *zbuffer);
 	Audio::SeekableAudioStream *decodeAudioFrame();
@@ -132,6 +135,22 @@ public:
 		uint16  frame;
 		uint32  size;
 		uint8  *data;
+
+		// The codebook converted to the format of the surface it was last drawn on
+		uint32                *colors;
+		Graphics::PixelFormat  colorsFormat;
+	};
+
+	// A frame's chunks read into memory ahead of time, parsed by readFrame() from there
+	struct ReadAheadPacket {
+		int     frame;
+		uint32  size;
+		uint32  capacity;
+		uint8  *data;
+	};
+
+	enum {
+		kReadAheadPackets = 2 // The next video frame and the next audio frame
 	};
 
 	class VQAVideoTrack;
@@ -146,6 +165,9 @@ public:
 
 	Common::Array<CodebookInfo> _codebooks;
 
+	ReadAheadPacket _readAhead[kReadAheadPackets];
+	int             _readAheadNext;
+
 	uint32  *_frameInfo;
 
 	uint32   _maxVIEWChunkSize;
@@ -193,6 +215,8 @@ public:
 		bool readAESC(Common::SeekableReadStream *s, uint32 size);
 		bool readLITE(Common::SeekableReadStream *s, uint32 size);
 
+		void convertCodebook(CodebookInfo &codebookInfo, const Graphics::PixelFormat &format);
+
 	protected:
 		Common::Rational getFrameRate() const;
 
@@ -215,6 +239,7 @@ public:
 		uint32  _maxZBUFChunkSize;
 
 		uint8   *_codebook;
+		uint32  *_codebookColors;
 		uint8   *_cbfz;
 		uint32   _zbufChunkSize;
 		uint8   *_zbufChunk;
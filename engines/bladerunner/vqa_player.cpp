@@ -32,6 +32,8 @@
 
 namespace BladeRunner {
 
+static const int kAudioPreloadFrames = 14;
+
 bool VQAPlayer::open() {
 	_s = _vm->getResourceStream(_name);
 	if (!_s) {
@@ -120,6 +122,7 @@ int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics:
 		// _repeatsCount == 0, so return here at the end of the video, to release the resource
 		return result;
 	} else if (useTime && (now < _frameNextTime)) {
+		readAhead();
 		result = -1;
 	} else if (advanceFrame) {
 		_frame = _frameNext;
@@ -127,9 +130,8 @@ int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics:
 		_decoder.decodeVideoFrame(customSurface != nullptr ? customSurface : _surface, _frameNext);
 
 		if (_hasAudio) {
-			int audioPreloadFrames = 14;
 			if (!_audioStarted) {
-				for (int i = 0; i < audioPreloadFrames; i++) {
+				for (int i = 0; i < kAudioPreloadFrames; i++) {
 					if (_frameNext + i < _frameEnd) {
 						_decoder.readFrame(_frameNext + i, kVQAReadAudio);
 						queueAudioFrame(_decoder.decodeAudioFrame());
@@ -138,8 +140,8 @@ int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics:
 				_vm->_mixer->playStream(Audio::Mixer::kSFXSoundType, &_soundHandle, _audioStream);
 				_audioStarted = true;
 			}
-			if (_frameNext + audioPreloadFrames < _frameEnd) {
-				_decoder.readFrame(_frameNext + audioPreloadFrames, kVQAReadAudio);
+			if (_frameNext + kAudioPreloadFrames < _frameEnd) {
+				_decoder.readFrame(_frameNext + kAudioPreloadFrames, kVQAReadAudio);
 				queueAudioFrame(_decoder.decodeAudioFrame());
 			}
 		}
@@ -242,6 +244,7 @@ bool VQAPlayer::setBeginAndEndFrame(int begin, int end, int repeatsCount, int lo
 }
 
 bool VQAPlayer::seekToFrame(int frame) {
+	_decoder.discardReadAhead();
 	_frameNext = frame;
 	_frameNextTime = 60 * _vm->_time->currentSystem();
 	return true;
@@ -267,6 +270,31 @@ int VQAPlayer::getFrameCount() {
 	return _decoder.numFrames();
 }
 
+void VQAPlayer::readAhead() {
+	// Read the frame update() will show next, and the audio it will queue with it,
+	// while waiting for that frame to be due. A loop enqueued by setLoop() has
+	// already set _frameBegin, so wrapping around follows it as update() will.
+	int frame = _frameNext < 0 ? _frameBegin : _frameNext;
+	int frameEnd = _frameEnd;
+	if (frame > _frameEnd) {
+		if (_repeatsCount == 0) {
+			return;
+		}
+		frame = _frameBegin;
+		if (_frameEndQueued != -1) {
+			frameEnd = _frameEndQueued;
+		}
+	}
+	if (frame < 0) {
+		return;
+	}
+
+	_decoder.readAhead(frame, _surface->format);
+	if (_hasAudio && _audioStarted && frame + kAudioPreloadFrames < frameEnd) {
+		_decoder.readAhead(frame + kAudioPreloadFrames, _surface->format);
+	}
+}
+
 void VQAPlayer::queueAudioFrame(Audio::AudioStream *audioStream) {
 	int n = _audioStream->numQueuedStreams();
 	if (n == 0)
@@ -124,6 +124,7 @@ public:
 
 private:
 	void queueAudioFrame(Audio::AudioStream *audioStream);
+	void readAhead();
 };
 
 } // End of namespace BladeRunner
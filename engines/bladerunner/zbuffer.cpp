@@ -175,6 +175,12 @@ uint16 *ZBuffer::getData() const {
 	return _zbuf2;
 }
 
+#if BLADERUNNER_DEBUG_SLICE_BENCH
+const uint16 *ZBuffer::getBackgroundData() const {
+	return _zbuf1;
+}
+#endif
+
 uint16 ZBuffer::getZValue(int x, int y) const {
 	assert(x >= 0 && x < _width);
 	assert(y >= 0 && y < _height);
@@ -66,6 +66,9 @@ public:
 	bool decodeData(const uint8 *data, int size);
 
 	uint16 *getData() const;
+#if BLADERUNNER_DEBUG_SLICE_BENCH
+	const uint16 *getBackgroundData() const;
+#endif
 	uint16 getZValue(int x, int y) const;
 
 private:
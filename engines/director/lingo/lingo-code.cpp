@@ -64,10 +64,10 @@ static struct FuncDescr {
 	{ Lingo::c_fconstpush,	"c_fconstpush",	"f" },
 	{ Lingo::c_stringpush,	"c_stringpush",	"s" },
 	{ Lingo::c_symbolpush,	"c_symbolpush",	"s" },	// D3
-	{ Lingo::c_varpush,		"c_varpush",	"s" },
+	{ Lingo::c_varpush,		"c_varpush",	"n" },
 	{ Lingo::c_setImmediate,"c_setImmediate","i" },
 	{ Lingo::c_assign,		"c_assign",		"" },
-	{ Lingo::c_eval,		"c_eval",		"s" },
+	{ Lingo::c_eval,		"c_eval",		"n" },
 	{ Lingo::c_theentitypush,"c_theentitypush","ii" }, // entity, field
 	{ Lingo::c_theentityassign,"c_theentityassign","ii" },
 	{ Lingo::c_swap,		"c_swap",		"" },
@@ -255,27 +255,26 @@ void Lingo::c_arraypush() {
 }
 
 void Lingo::c_varpush() {
-	Common::String name((char *)&(*g_lingo->_currentScript)[g_lingo->_pc]);
+	inst i = (*g_lingo->_currentScript)[g_lingo->_pc++];
+	int nameId = READ_UINT32(&i);
 	Datum d;
 
-	g_lingo->_pc += g_lingo->calcStringAlignment(name.c_str());
-
 	// In immediate mode we will push variables as strings
 	// This is used for playAccel
 	if (g_lingo->_immediateMode) {
-		g_lingo->push(Datum(new Common::String(name)));
+		g_lingo->push(Datum(new Common::String(g_lingo->_names[nameId].name)));
 
 		return;
 	}
 
-	if (g_lingo->getHandler(name) != NULL) {
+	if (g_lingo->getNameHandler(nameId) != NULL) {
 		d.type = HANDLER;
-		d.u.s = new Common::String(name);
+		d.u.s = new Common::String(g_lingo->_names[nameId].name);
 		g_lingo->push(d);
 		return;
 	}
 
-	d.u.sym = g_lingo->lookupVar(name.c_str());
+	d.u.sym = g_lingo->lookupNameVar(nameId);
 	if (d.u.sym->type == CASTREF) {
 		d.type = INT;
 		int val = d.u.sym->u.i;
@@ -1113,6 +1112,7 @@ void Lingo::call(Common::String name, int nargs) {
 
 	// Create new set of local variables
 	g_lingo->_localvars = new SymbolHash;
+	g_lingo->_localvarsSerial++;
 
 	g_lingo->_callstack.push_back(fp);
 
@@ -1141,6 +1141,7 @@ void Lingo::c_procret() {
 
 	// Restore local variables
 	g_lingo->_localvars = fp->localvars;
+	g_lingo->_localvarsSerial++;
 
 	delete fp;
 
@@ -1158,6 +1159,9 @@ void Lingo::c_global() {
 	s = g_lingo->lookupVar(name.c_str(), true, true);
 	s->global = true;
 
+	// Variables of this name resolve to the global from now on
+	g_lingo->_localvarsSerial++;
+
 	g_lingo->_pc += g_lingo->calcStringAlignment(name.c_str());
 }
 
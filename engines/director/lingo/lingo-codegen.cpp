@@ -54,12 +54,14 @@ namespace Director {
 
 void Lingo::execute(uint pc) {
 	for(_pc = pc; (*_currentScript)[_pc] != STOP && !_returning;) {
-		Common::String instr = decodeInstruction(_pc);
-
 		if (debugChannelSet(5, kDebugLingoExec))
 			printStack("Stack before: ");
 
-		debugC(1, kDebugLingoExec, "[%3d]: %s", _pc, instr.c_str());
+		// Decoding is expensive, only do it when it gets printed
+		if (debugChannelSet(1, kDebugLingoExec)) {
+			Common::String instr = decodeInstruction(_pc);
+			debugC(1, kDebugLingoExec, "[%3d]: %s", _pc, instr.c_str());
+		}
 
 		_pc++;
 		(*((*_currentScript)[_pc - 1]))();
@@ -125,6 +127,14 @@ Common::String Lingo::decodeInstruction(uint pc, uint *newPc) {
 					res += Common::String::format(" \"%s\"", s);
 					break;
 				}
+			case 'n':
+				{
+					i = (*_currentScript)[pc++];
+					int v = READ_UINT32(&i);
+
+					res += Common::String::format(" \"%s\"", _names[v].name.c_str());
+					break;
+				}
 			default:
 				warning("decodeInstruction: Unknown parameter type: %c", pars[-1]);
 			}
@@ -192,6 +202,58 @@ Symbol *Lingo::lookupVar(const char *name, bool create, bool putInGlobalList) {
 	return sym;
 }
 
+int Lingo::intern(const char *name) {
+	if (_nameIds.contains(name))
+		return _nameIds[name];
+
+	InternedName n;
+
+	n.name = name;
+	n.isEvent = _eventHandlerTypeIds.contains(name);
+	n.builtin = NULL;
+	n.builtinSerial = 0;
+	n.var = NULL;
+	n.varSerial = 0;
+
+	_names.push_back(n);
+	_nameIds[name] = _names.size() - 1;
+
+	return _names.size() - 1;
+}
+
+Symbol *Lingo::getNameHandler(int nameId) {
+	InternedName &n = _names[nameId];
+
+	if (n.isEvent)
+		return getHandler(n.name);
+
+	if (n.builtinSerial != _builtinsSerial) {
+		n.builtin = _builtins.contains(n.name) ? _builtins[n.name] : NULL;
+		n.builtinSerial = _builtinsSerial;
+	}
+
+	return n.builtin;
+}
+
+Symbol *Lingo::lookupNameVar(int nameId) {
+	InternedName &n = _names[nameId];
+
+	if (n.varSerial == _localvarsSerial)
+		return n.var;
+
+	Symbol *sym = lookupVar(n.name.c_str());
+
+	// Only variables of the current scope stay put until the scope changes.
+	// Cast references are temporary and globals not declared in this scope
+	// may be shadowed by a new local later on.
+	if (sym->type != CASTREF && _localvars && _localvars->contains(n.name)) {
+		n.var = sym;
+		n.varSerial = _localvarsSerial;
+	}
+
+	return sym;
+}
+
 void Lingo::cleanLocalVars() {
 	// Clean up current scope local variables and clean up memory
 	debugC(3, kDebugLingoExec, "cleanLocalVars: have %d vars", _localvars->size());
@@ -205,6 +267,7 @@ void Lingo::cleanLocalVars() {
 	delete g_lingo->_localvars;
 
 	g_lingo->_localvars = 0;
+	g_lingo->_localvarsSerial++;
 }
 
 void Lingo::define(Common::String &name, int start, int nargs, Common::String *prefix, int end) {
@@ -232,6 +295,8 @@ void Lingo::define(Common::String &name, int start, int nargs, Common::String *p
 		delete sym->u.defn;
 	}
 
+	_builtinsSerial++;
+
 	if (end == -1)
 		end = _currentScript->size();
 
@@ -257,6 +322,14 @@ int Lingo::codeString(const char *str) {
 	return _currentScript->size();
 }
 
+int Lingo::codeName(const char *s) {
+	inst i = 0;
+	WRITE_UINT32(&i, intern(s));
+	code1(i);
+
+	return _currentScript->size();
+}
+
 int Lingo::codeFloat(double f) {
 	int numInsts = calcCodeAlignment(sizeof(double));
 
@@ -306,7 +379,7 @@ void Lingo::codeArgStore() {
 		_argstack.pop_back();
 
 		code1(c_varpush);
-		codeString(arg->c_str());
+		codeName(arg->c_str());
 		code1(c_assign);
 
 		delete arg;
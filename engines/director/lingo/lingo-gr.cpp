@@ -2161,7 +2161,7 @@ yyreduce:
 #line 135 "engines/director/lingo/lingo-gr.y"
     {
 		g_lingo->code1(g_lingo->c_varpush);
-		g_lingo->codeString((yyvsp[(4) - (4)].s)->c_str());
+		g_lingo->codeName((yyvsp[(4) - (4)].s)->c_str());
 		g_lingo->code1(g_lingo->c_assign);
 		(yyval.code) = (yyvsp[(2) - (4)].code);
 		delete (yyvsp[(4) - (4)].s); ;}
@@ -2188,7 +2188,7 @@ yyreduce:
 #line 146 "engines/director/lingo/lingo-gr.y"
     {
 		g_lingo->code1(g_lingo->c_varpush);
-		g_lingo->codeString((yyvsp[(2) - (4)].s)->c_str());
+		g_lingo->codeName((yyvsp[(2) - (4)].s)->c_str());
 		g_lingo->code1(g_lingo->c_assign);
 		(yyval.code) = (yyvsp[(4) - (4)].code);
 		delete (yyvsp[(2) - (4)].s); ;}
@@ -2222,7 +2222,7 @@ yyreduce:
 #line 168 "engines/director/lingo/lingo-gr.y"
     {
 		g_lingo->code1(g_lingo->c_varpush);
-		g_lingo->codeString((yyvsp[(2) - (4)].s)->c_str());
+		g_lingo->codeName((yyvsp[(2) - (4)].s)->c_str());
 		g_lingo->code1(g_lingo->c_assign);
 		(yyval.code) = (yyvsp[(4) - (4)].code);
 		delete (yyvsp[(2) - (4)].s); ;}
@@ -2591,7 +2591,7 @@ yyreduce:
 #line 438 "engines/director/lingo/lingo-gr.y"
     {
 		(yyval.code) = g_lingo->code1(g_lingo->c_eval);
-		g_lingo->codeString((yyvsp[(1) - (1)].s)->c_str());
+		g_lingo->codeName((yyvsp[(1) - (1)].s)->c_str());
 		delete (yyvsp[(1) - (1)].s); ;}
     break;
 
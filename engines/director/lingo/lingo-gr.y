@@ -134,7 +134,7 @@ programline: /* empty */
 
 asgn: tPUT expr tINTO ID 		{
 		g_lingo->code1(g_lingo->c_varpush);
-		g_lingo->codeString($4->c_str());
+		g_lingo->codeName($4->c_str());
 		g_lingo->code1(g_lingo->c_assign);
 		$$ = $2;
 		delete $4; }
@@ -145,7 +145,7 @@ asgn: tPUT expr tINTO ID 		{
 	| tPUT expr tBEFORE expr 		{ $$ = g_lingo->code1(g_lingo->c_before); }		// D3
 	| tSET ID '=' expr			{
 		g_lingo->code1(g_lingo->c_varpush);
-		g_lingo->codeString($2->c_str());
+		g_lingo->codeName($2->c_str());
 		g_lingo->code1(g_lingo->c_assign);
 		$$ = $4;
 		delete $2; }
@@ -167,7 +167,7 @@ asgn: tPUT expr tINTO ID 		{
 		$$ = $5; }
 	| tSET ID tTO expr			{
 		g_lingo->code1(g_lingo->c_varpush);
-		g_lingo->codeString($2->c_str());
+		g_lingo->codeName($2->c_str());
 		g_lingo->code1(g_lingo->c_assign);
 		$$ = $4;
 		delete $2; }
@@ -437,7 +437,7 @@ expr: INT		{ $$ = g_lingo->codeConst($1); }
 		delete $1; }
 	| ID		{
 		$$ = g_lingo->code1(g_lingo->c_eval);
-		g_lingo->codeString($1->c_str());
+		g_lingo->codeName($1->c_str());
 		delete $1; }
 	| THEENTITY	{
 		$$ = g_lingo->codeConst(0); // Put dummy id
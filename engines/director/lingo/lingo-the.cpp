@@ -20,6 +20,8 @@
  *
  */
 
+#include "common/system.h"
+
 #include "director/lingo/lingo.h"
 #include "director/cast.h"
 #include "director/sprite.h"
@@ -434,6 +436,11 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 		d.type = INT;
 		d.u.i = _floatPrecision;
 		break;
+	case kTheTicks:
+		// 1/60th of a second since startup
+		d.type = INT;
+		d.u.i = g_system->getMillis() * 60 / 1000;
+		break;
 	case kTheSqrt:
 		id.toFloat();
 		d.type = FLOAT;
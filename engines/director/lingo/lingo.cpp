@@ -68,6 +68,8 @@ Lingo::Lingo(DirectorEngine *vm) : _vm(vm) {
 	_exitRepeat = false;
 
 	_localvars = NULL;
+	_localvarsSerial = 1;
+	_builtinsSerial = 1;
 
 	initEventHandlerTypes();
 
@@ -215,6 +217,7 @@ void Lingo::executeScript(ScriptType type, uint16 id) {
 	_returning = false;
 
 	_localvars = new SymbolHash;
+	_localvarsSerial++;
 
 	execute(_pc);
 
@@ -148,6 +148,16 @@ typedef Common::HashMap<Common::String, Builtin *, Common::IgnoreCase_Hash, Comm
 typedef Common::HashMap<Common::String, TheEntity *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TheEntityHash;
 typedef Common::HashMap<Common::String, TheEntityField *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TheEntityFieldHash;
 
+struct InternedName {	/* name operand of c_varpush and c_eval */
+	Common::String name;
+	bool isEvent;	/* event handlers are looked up per entity, never cached */
+
+	Symbol *builtin;	/* cached _builtins entry, valid while builtinSerial matches */
+	uint32 builtinSerial;
+	Symbol *var;		/* cached variable, valid while varSerial matches */
+	uint32 varSerial;
+};
+
 struct CFrame {	/* proc/func call stack frame */
 	Symbol	*sp;	/* symbol table entry */
 	int		retpc;	/* where to resume after return */
@@ -197,6 +207,9 @@ public:
 	void pushContext();
 	void popContext();
 	Symbol *lookupVar(const char *name, bool create = true, bool putInGlobalList = false);
+	Symbol *lookupNameVar(int nameId);
+	Symbol *getNameHandler(int nameId);
+	int intern(const char *name);
 	void cleanLocalVars();
 	void define(Common::String &s, int start, int nargs, Common::String *prefix = NULL, int end = -1);
 	void processIf(int elselabel, int endlabel);
@@ -207,6 +220,7 @@ public:
 	int code2(inst code_1, inst code_2) { int o = code1(code_1); code1(code_2); return o; }
 	int code3(inst code_1, inst code_2, inst code_3) { int o = code1(code_1); code1(code_2); code1(code_3); return o; }
 	int codeString(const char *s);
+	int codeName(const char *s);
 	void codeLabel(int label);
 	int codeConst(int val);
 	int codeArray(int arraySize);
@@ -555,6 +569,13 @@ private:
 	SymbolHash _globalvars;
 	SymbolHash *_localvars;
 
+	// Interned variable and handler names. _localvarsSerial changes whenever the
+	// variable scope does, _builtinsSerial whenever a handler gets defined.
+	Common::Array<InternedName> _names;
+	Common::HashMap<Common::String, int> _nameIds;
+	uint32 _localvarsSerial;
+	uint32 _builtinsSerial;
+
 	FuncHash _functions;
 
 	uint _pc;
@@ -23,7 +23,10 @@
 #include "glk/debugger.h"
 #include "glk/glk.h"
 #include "glk/raw_decoder.h"
+#include "glk/window_text_buffer.h"
+#include "glk/windows.h"
 #include "common/file.h"
+#include "common/system.h"
 #include "graphics/managed_surface.h"
 #include "image/png.h"
 
@@ -31,6 +34,7 @@ namespace Glk {
 
 Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("dumppic", WRAP_METHOD(Debugger, cmdDumpPic));
+	registerCmd("text_bench", WRAP_METHOD(Debugger, cmdTextBench));
 }
 
 int Debugger::strToInt(const char *s) {
@@ -100,6 +104,48 @@ bool Debugger::cmdDumpPic(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdTextBench(int argc, const char **argv) {
+	int numLines = (argc >= 2) ? strToInt(argv[1]) : 5000;
+	if (numLines <= 0) {
+		debugPrintf("Format: text_bench [number of lines]\n");
+		return true;
+	}
+
+	Windows &windows = *g_vm->_windows;
+	TextBufferWindow *win = dynamic_cast<TextBufferWindow *>(windows.windowOpen(windows.getRoot(),
+		winmethod_Below | winmethod_Proportional, 50, wintype_TextBuffer, 0));
+	if (!win) {
+		debugPrintf("Could not open a text buffer window\n");
+		return true;
+	}
+
+	// Stream a transcript of varying line lengths, so that some lines get wrapped
+	const char *const SENTENCE = "You are standing in an open field west of a white house, with a boarded front door. ";
+	uint32 startTime = g_system->getMillis();
+	for (int lineNum = 0; lineNum < numLines; ++lineNum) {
+		Common::String text = Common::String::format("%d. ", lineNum);
+		for (int idx = 0; idx <= lineNum % 4; ++idx)
+			text += SENTENCE;
+		text += '\n';
+
+		Common::U32String line(text);
+		win->_stream->putBufferUni(line.c_str(), line.size());
+	}
+	uint32 streamTime = g_system->getMillis() - startTime;
+
+	// Narrowing and restoring the window reflows the scrollback twice
+	Rect box = win->_bbox;
+	startTime = g_system->getMillis();
+	win->rearrange(Rect(box.left, box.top, box.right - box.width() / 4, box.bottom));
+	win->rearrange(box);
+	uint32 reflowTime = g_system->getMillis() - startTime;
+
+	windows.windowClose(win);
+
+	debugPrintf("Streamed %d lines in %ums, reflowed twice in %ums\n", numLines, streamTime, reflowTime);
+	return true;
+}
+
 void Debugger::saveRawPicture(const RawDecoder &rd, Common::WriteStream &ws) {
 #ifdef USE_PNG
 	const Graphics::Surface *surface = rd.getSurface();
@@ -43,6 +43,11 @@ private:
 	 * Dump a picture
 	 */
 	bool cmdDumpPic(int argc, const char **argv);
+
+	/**
+	 * Time streaming a long transcript into a text buffer window, and reflowing it
+	 */
+	bool cmdTextBench(int argc, const char **argv);
 protected:
 	/**
 	 * Convert a numeric string to an integer
@@ -29,7 +29,7 @@ void Glulxe::execute_loop() {
 	bool done_executing = false;
 	int ix;
 	uint opcode;
-	const operandlist_t *oplist;
+	const decodedinst_t *decoded;
 	oparg_t inst[MAX_OPERANDS];
 	uint value, addr, val0, val1;
 	int vals0, vals1;
@@ -39,7 +39,12 @@ void Glulxe::execute_loop() {
 	gfloat32 valf, valf1, valf2;
 #endif /* FLOAT_SUPPORT */
 
-	while (!done_executing && !g_vm->shouldQuit()) {
+	while (!done_executing) {
+		/* Checking for quit means asking the event manager, so only do it
+		   every so often. Glk calls in between will return as soon as a
+		   quit has been requested anyway. */
+		if ((++exec_opcount & 0x3FF) == 0 && g_vm->shouldQuit())
+			break;
 
 		profile_tick();
 		debugger_tick();
@@ -49,44 +54,15 @@ void Glulxe::execute_loop() {
 		/* Stash the current opcode's address, in case the interpreter needs to serialize the VM state out-of-band. */
 		prevpc = pc;
 
-		/* Fetch the opcode number. */
-		opcode = Mem1(pc);
-		pc++;
-		if (opcode & 0x80) {
-			/* More than one-byte opcode. */
-			if (opcode & 0x40) {
-				/* Four-byte opcode */
-				opcode &= 0x3F;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-			} else {
-				/* Two-byte opcode */
-				opcode &= 0x7F;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-			}
-		}
-
-		/* Now we have an opcode number. */
-
-		/* Fetch the structure that describes how the operands for this
-		   opcode are arranged. This is a pointer to an immutable,
-		   static object. */
-		if (opcode < 0x80)
-			oplist = fast_operandlist[opcode];
-		else
-			oplist = lookup_operandlist(opcode);
-
-		if (!oplist)
-			fatal_error_i("Encountered unknown opcode.", opcode);
+		/* Fetch the opcode number, and how its operands are arranged.
+		   Instructions in ROM only get decoded the first time through. */
+		decoded = fetch_instruction(pc);
+		opcode = decoded->opcode;
 
-		/* Based on the oplist structure, load the actual operand values
-		   into inst. This moves the PC up to the end of the instruction. */
-		parse_operands(inst, oplist);
+		/* Load the actual operand values into inst, and move the PC up
+		   to the end of the instruction. */
+		load_operands(inst, decoded);
+		pc = decoded->nextpc;
 
 		/* Perform the opcode. This switch statement is split in two, based
 		   on some paranoid suspicions about the ability of compilers to
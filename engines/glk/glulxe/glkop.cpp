@@ -21,6 +21,7 @@
  */
 
 #include "glk/glulxe/glulxe.h"
+#include "common/system.h"
 
 namespace Glk {
 namespace Glulxe {
@@ -151,6 +152,9 @@ uint Glulxe::perform_glk(uint funcnum, uint numargs, uint *arglist) {
 		glk_put_char_stream(find_stream_by_id(arglist[0]), arglist[1] & 0xFF);
 		break;
 	case 0x00C0: /* select */
+		debugC(kDebugScripts, "Turn took %ums for %u instructions",
+			g_system->getMillis() - turn_start_time, exec_opcount - turn_start_opcount);
+
 		/* call a library hook on every glk_select() */
 		if (library_select_hook)
 			library_select_hook(arglist[0]);
@@ -226,6 +230,12 @@ FullDispatcher:
 	}
 	}
 
+	if (funcnum == 0x00C0) {
+		/* The next turn starts once the game gets its event. */
+		turn_start_time = g_system->getMillis();
+		turn_start_opcount = exec_opcount;
+	}
+
 	return retval;
 }
 
@@ -22,6 +22,7 @@
 
 #include "glk/glulxe/glulxe.h"
 #include "common/config-manager.h"
+#include "common/system.h"
 #include "common/translation.h"
 
 namespace Glk {
@@ -34,6 +35,7 @@ Glulxe::Glulxe(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst,
 		ramstart(0), endgamefile(0), origendmem(0),  stacksize(0), startfuncaddr(0), checksum(0),
 		stackptr(0), frameptr(0), pc(0), prevpc(0), origstringtable(0), stringtable(0), valstackbase(0),
 		localsbase(0), endmem(0), protectstart(0), protectend(0),
+		exec_opcount(0), turn_start_opcount(0), turn_start_time(0),
 		stream_char_handler(nullptr), stream_unichar_handler(nullptr),
 		// main
 		library_autorestore_hook(nullptr),
@@ -43,8 +45,12 @@ Glulxe::Glulxe(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst,
 		accelentries(nullptr),
 		// heap
 		heap_start(0), alloc_count(0), heap_head(nullptr), heap_tail(nullptr),
+		// operand
+		decodecache(nullptr),
 		// serial
-		max_undo_level(8), undo_chain_size(0), undo_chain_num(0), undo_chain(nullptr), ramcache(nullptr),
+		max_undo_level(32), max_undo_bytes(4 * 1024 * 1024), undo_chain_size(0), undo_chain_num(0),
+		undo_chain(nullptr), undo_chain_lens(nullptr), undo_chain_bytes(0), undo_ram(nullptr),
+		undo_ram_len(0), undo_ram_size(0), ramcache(nullptr),
 		// string
 		iosys_mode(0), iosys_rock(0), tablecache_valid(false), glkio_unichar_han_ptr(nullptr) {
 	g_vm = this;
@@ -63,6 +69,10 @@ void Glulxe::runGame() {
 	if (library_autorestore_hook)
 		library_autorestore_hook();
 
+	/* The first turn runs from here to the game's first glk_select() */
+	turn_start_time = g_system->getMillis();
+	turn_start_opcount = exec_opcount;
+
 	execute_loop();
 	finalize_vm();
 
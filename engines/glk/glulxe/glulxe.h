@@ -71,6 +71,13 @@ private:
 	uint protectstart, protectend;
 	uint prevpc;
 
+	/**
+	 * Number of instructions executed, and when the current turn started, for timing turns
+	 */
+	uint exec_opcount;
+	uint turn_start_opcount;
+	uint32 turn_start_time;
+
 	/**@}*/
 
 	/**
@@ -143,6 +150,17 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Decoded instructions from ROM, indexed by address. ROM can't change, so entries
+	 * never need to be invalidated
+	 */
+	decodedinst_t *decodecache;
+
+	/**
+	 * Decoded instruction from RAM, which isn't cached
+	 */
+	decodedinst_t decodescratch;
+
 	/**@}*/
 
 	/**
@@ -155,9 +173,26 @@ private:
 	 */
 	int max_undo_level;
 
+	/**
+	 * Total size in bytes the undo chain may use, beyond which the oldest states get dropped.
+	 * The most recent state is always kept
+	 */
+	uint max_undo_bytes;
+
 	int undo_chain_size;
 	int undo_chain_num;
 	byte **undo_chain;
+	uint *undo_chain_lens;
+	uint undo_chain_bytes;
+
+	/**
+	 * Copy of RAM (ramstart to endmem) in the most recent undo state. Each state in the undo
+	 * chain only stores how its RAM differs from the next older state, which gets rebuilt
+	 * from this copy when undoing.
+	 */
+	byte *undo_ram;
+	uint undo_ram_len;
+	uint undo_ram_size;
 
 	/**
 	 * This will contain a copy of RAM (ramstate to endmem) as it exists in the game file.
@@ -357,6 +392,27 @@ protected:
 	uint write_heapstate_sub(uint sumlen, uint *sumarray, dest_t *dest, int portable);
 	static int sort_heap_summary(const void *p1, const void *p2);
 
+	/**
+	 * Writes the RAM for an undo state, as the difference from the previous undo state,
+	 * and updates the copy of the most recent undo state's RAM
+	 */
+	uint write_undo_memstate(dest_t *dest);
+
+	/**
+	 * Restores RAM from the most recent undo state
+	 */
+	uint read_undo_memstate(dest_t *dest, uint chunklen);
+
+	/**
+	 * Turns the copy of the most recent undo state's RAM into that of the next older state
+	 */
+	void apply_undo_delta(const byte *delta, uint len);
+
+	/**
+	 * Drops the oldest state from the undo chain
+	 */
+	void drop_oldest_undo();
+
 	int read_byte(dest_t *dest, byte *val);
 	int read_short(dest_t *dest, uint16 *val);
 	int read_long(dest_t *dest, uint *val);
@@ -530,13 +586,21 @@ public:
 	const operandlist_t *lookup_operandlist(uint opcode);
 
 	/**
-	 * Read the list of operands of an instruction, and put the values in args. This assumes
-	 * that the PC is at the beginning of the operand mode list (right after an opcode number.)
-	 * Upon return, the PC will be at the beginning of the next instruction.
-	 *
-	 * This also assumes that args points at an allocated array of MAX_OPERANDS oparg_t structures.
+	 * Return the decoded instruction at the given address. Instructions in ROM come from
+	 * the decode cache, others are decoded into a scratch entry on every call.
+	 */
+	const decodedinst_t *fetch_instruction(uint addr);
+
+	/**
+	 * Decode the opcode and operand modes of the instruction at the given address
+	 */
+	void decode_instruction(decodedinst_t *decoded, uint addr);
+
+	/**
+	 * Load the operand values of a decoded instruction, and put them in args. This assumes
+	 * that args points at an allocated array of MAX_OPERANDS oparg_t structures.
 	*/
-	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
+	void load_operands(oparg_t *opargs, const decodedinst_t *decoded);
 
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
@@ -352,6 +352,39 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * How an operand of a decoded instruction gets its value, or where a result gets stored
+ */
+enum operandkind {
+	opkind_Const = 0,       ///< the value is the constant in arg
+	opkind_Pop = 1,         ///< pop the value off the stack
+	opkind_Mem = 2,         ///< load from main memory at address arg
+	opkind_Local = 3,       ///< load from the locals segment at offset arg
+	opkind_StoreDiscard = 4,
+	opkind_StorePush = 5,
+	opkind_StoreMem = 6,
+	opkind_StoreLocal = 7
+};
+
+/**
+ * An instruction with its opcode and operand modes already decoded. Operand values from
+ * the stack, memory or locals still have to be loaded each time the instruction executes.
+ */
+struct decodedinst_struct {
+	uint addr;              ///< Address of the instruction, or zero for an unused cache entry
+	uint nextpc;            ///< Address of the following instruction
+	uint opcode;
+	const operandlist_t *oplist;
+	byte kinds[MAX_OPERANDS];
+	uint args[MAX_OPERANDS];
+};
+typedef decodedinst_struct decodedinst_t;
+
+/**
+ * Number of instructions kept decoded. Must be a power of two
+ */
+#define DECODE_CACHE_SIZE (8192)
+
 typedef uint(Glulxe::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
@@ -67,6 +67,13 @@ static const operandlist_t list_LLSS = { 4, 4, &array_LLSS[0] };
 void Glulxe::init_operands() {
 	for (int ix = 0; ix < 0x80; ix++)
 		fast_operandlist[ix] = lookup_operandlist(ix);
+
+	/* Without a decode cache, every instruction just gets decoded
+	   as it's executed. */
+	if (!decodecache)
+		decodecache = (decodedinst_t *)glulx_malloc(DECODE_CACHE_SIZE * sizeof(decodedinst_t));
+	if (decodecache)
+		memset(decodecache, 0, DECODE_CACHE_SIZE * sizeof(decodedinst_t));
 }
 
 const operandlist_t *Glulxe::lookup_operandlist(uint opcode) {
@@ -280,22 +287,74 @@ const operandlist_t *Glulxe::lookup_operandlist(uint opcode) {
 	}
 }
 
-void Glulxe::parse_operands(oparg_t *args, const operandlist_t *oplist) {
+const decodedinst_t *Glulxe::fetch_instruction(uint addr) {
+	decodedinst_t *decoded;
+
+	if (addr < ramstart && decodecache) {
+		decoded = &decodecache[addr & (DECODE_CACHE_SIZE - 1)];
+		if (decoded->addr != addr)
+			decode_instruction(decoded, addr);
+	} else {
+		/* RAM may get modified, so instructions there are always decoded
+		   afresh. */
+		decoded = &decodescratch;
+		decode_instruction(decoded, addr);
+	}
+
+	return decoded;
+}
+
+void Glulxe::decode_instruction(decodedinst_t *decoded, uint addr) {
+	uint opcode;
+	const operandlist_t *oplist;
 	int ix;
-	oparg_t *curarg;
-	int numops = oplist->num_ops;
-	int argsize = oplist->arg_size;
-	uint modeaddr = pc;
+	int numops;
+	uint modeaddr;
 	int modeval = 0;
 
-	pc += (numops + 1) / 2;
+	decoded->addr = addr;
+
+	/* Fetch the opcode number. */
+	opcode = Mem1(addr);
+	addr++;
+	if (opcode & 0x80) {
+		/* More than one-byte opcode. */
+		if (opcode & 0x40) {
+			/* Four-byte opcode */
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		} else {
+			/* Two-byte opcode */
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		}
+	}
+
+	/* Fetch the structure that describes how the operands for this
+	   opcode are arranged. This is a pointer to an immutable,
+	   static object. */
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
 
-	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
-		int mode;
-		uint value;
-		uint addr;
+	if (!oplist)
+		fatal_error_i("Encountered unknown opcode.", opcode);
+
+	numops = oplist->num_ops;
+	modeaddr = addr;
+	addr += (numops + 1) / 2;
 
-		curarg->desttype = 0;
+	for (ix = 0; ix < numops; ix++) {
+		int mode;
+		uint arg = 0;
+		byte kind;
 
 		if ((ix & 1) == 0) {
 			modeval = Mem1(modeaddr);
@@ -305,215 +364,209 @@ void Glulxe::parse_operands(oparg_t *args, const operandlist_t *oplist) {
 			modeaddr++;
 		}
 
-		if (oplist->formlist[ix] == modeform_Load) {
+		/* Read whatever constant or address follows the mode list. */
+		switch (mode) {
+		case 0: /* constant zero, or discard value */
+		case 8: /* pop off stack, or push on stack */
+			break;
+
+		case 1: /* one-byte constant */
+			/* Sign-extend from 8 bits to 32 */
+			arg = (int)(signed char)(Mem1(addr));
+			addr++;
+			break;
+
+		case 2: /* two-byte constant */
+			/* Sign-extend the first byte from 8 bits to 32; the subsequent
+			   byte must not be sign-extended. */
+			arg = (int)(signed char)(Mem1(addr));
+			addr++;
+			arg = (arg << 8) | (uint)(Mem1(addr));
+			addr++;
+			break;
+
+		case 3: /* four-byte constant */
+		case 7: /* main memory, four-byte address */
+		case 11: /* locals, four-byte address */
+			/* Bytes must not be sign-extended. */
+			arg = Mem4(addr);
+			addr += 4;
+			break;
+
+		case 15: /* main memory RAM, four-byte address */
+			arg = Mem4(addr) + ramstart;
+			addr += 4;
+			break;
+
+		case 6: /* main memory, two-byte address */
+		case 10: /* locals, two-byte address */
+			arg = (uint)Mem2(addr);
+			addr += 2;
+			break;
+
+		case 14: /* main memory RAM, two-byte address */
+			arg = (uint)Mem2(addr) + ramstart;
+			addr += 2;
+			break;
+
+		case 5: /* main memory, one-byte address */
+		case 9: /* locals, one-byte address */
+			arg = (uint)(Mem1(addr));
+			addr++;
+			break;
+
+		case 13: /* main memory RAM, one-byte address */
+			arg = (uint)(Mem1(addr)) + ramstart;
+			addr++;
+			break;
+
+		default:
+			break;
+		}
 
+		if (oplist->formlist[ix] == modeform_Load) {
 			switch (mode) {
-
-			case 8: /* pop off stack */
-				if (stackptr < valstackbase + 4) {
-					fatal_error("Stack underflow in operand.");
-				}
-				stackptr -= 4;
-				value = Stk4(stackptr);
+			case 8:
+				kind = opkind_Pop;
 				break;
-
-			case 0: /* constant zero */
-				value = 0;
-				break;
-
-			case 1: /* one-byte constant */
-				/* Sign-extend from 8 bits to 32 */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				break;
-
-			case 2: /* two-byte constant */
-				/* Sign-extend the first byte from 8 bits to 32; the subsequent
-				   byte must not be sign-extended. */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				value = (value << 8) | (uint)(Mem1(pc));
-				pc++;
-				break;
-
-			case 3: /* four-byte constant */
-				/* Bytes must not be sign-extended. */
-				value = Mem4(pc);
-				pc += 4;
+			case 0:
+			case 1:
+			case 2:
+			case 3:
+				kind = opkind_Const;
 				break;
-
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto MainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto MainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto MainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto MainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto MainMemAddr;
-
-			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-MainMemAddr:
-				/* cases 5, 6, 7, 13, 14, 15 all wind up here. */
-				if (argsize == 4) {
-					value = Mem4(addr);
-				} else if (argsize == 2) {
-					value = Mem2(addr);
-				} else {
-					value = Mem1(addr);
-				}
+			case 5:
+			case 6:
+			case 7:
+			case 13:
+			case 14:
+			case 15:
+				kind = opkind_Mem;
 				break;
-
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto LocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto LocalsAddr;
-
-			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-LocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				addr += localsbase;
-				if (argsize == 4) {
-					value = Stk4(addr);
-				} else if (argsize == 2) {
-					value = Stk2(addr);
-				} else {
-					value = Stk1(addr);
-				}
+			case 9:
+			case 10:
+			case 11:
+				/* It's illegal for the address to not be four-byte aligned,
+				   or outside the locals segment, but we don't check this
+				   explicitly. A "strict mode" interpreter probably should. */
+				kind = opkind_Local;
 				break;
-
 			default:
-				value = 0;
+				kind = opkind_Const;
 				fatal_error("Unknown addressing mode in load operand.");
 			}
-
-			curarg->value = value;
-
 		} else { /* modeform_Store */
 			switch (mode) {
-
-			case 0: /* discard value */
-				curarg->desttype = 0;
-				curarg->value = 0;
+			case 0:
+				kind = opkind_StoreDiscard;
 				break;
-
-			case 8: /* push on stack */
-				curarg->desttype = 3;
-				curarg->value = 0;
+			case 8:
+				kind = opkind_StorePush;
 				break;
-
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto WrMainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrMainMemAddr:
-				/* cases 5, 6, 7 all wind up here. */
-				curarg->desttype = 1;
-				curarg->value = addr;
+			case 5:
+			case 6:
+			case 7:
+			case 13:
+			case 14:
+			case 15:
+				kind = opkind_StoreMem;
 				break;
-
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrLocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrLocalsAddr;
-
-			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrLocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				curarg->desttype = 2;
-				/* We don't add localsbase here; the store address for desttype 2
-				   is relative to the current locals segment, not an absolute
-				   stack position. */
-				curarg->value = addr;
+			case 9:
+			case 10:
+			case 11:
+				kind = opkind_StoreLocal;
 				break;
-
 			case 1:
 			case 2:
 			case 3:
+				kind = opkind_StoreDiscard;
 				fatal_error("Constant addressing mode in store operand.");
 				break;
-
 			default:
+				kind = opkind_StoreDiscard;
 				fatal_error("Unknown addressing mode in store operand.");
 			}
 		}
+
+		decoded->kinds[ix] = kind;
+		decoded->args[ix] = arg;
+	}
+
+	decoded->opcode = opcode;
+	decoded->oplist = oplist;
+	decoded->nextpc = addr;
+}
+
+void Glulxe::load_operands(oparg_t *args, const decodedinst_t *decoded) {
+	int ix;
+	oparg_t *curarg;
+	int numops = decoded->oplist->num_ops;
+	int argsize = decoded->oplist->arg_size;
+
+	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
+		uint arg = decoded->args[ix];
+
+		switch (decoded->kinds[ix]) {
+		case opkind_Const:
+			curarg->desttype = 0;
+			curarg->value = arg;
+			break;
+
+		case opkind_Pop:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			curarg->desttype = 0;
+			curarg->value = Stk4(stackptr);
+			break;
+
+		case opkind_Mem:
+			curarg->desttype = 0;
+			if (argsize == 4) {
+				curarg->value = Mem4(arg);
+			} else if (argsize == 2) {
+				curarg->value = Mem2(arg);
+			} else {
+				curarg->value = Mem1(arg);
+			}
+			break;
+
+		case opkind_Local:
+			arg += localsbase;
+			curarg->desttype = 0;
+			if (argsize == 4) {
+				curarg->value = Stk4(arg);
+			} else if (argsize == 2) {
+				curarg->value = Stk2(arg);
+			} else {
+				curarg->value = Stk1(arg);
+			}
+			break;
+
+		case opkind_StoreDiscard:
+			curarg->desttype = 0;
+			curarg->value = 0;
+			break;
+
+		case opkind_StorePush:
+			curarg->desttype = 3;
+			curarg->value = 0;
+			break;
+
+		case opkind_StoreMem:
+			curarg->desttype = 1;
+			curarg->value = arg;
+			break;
+
+		default: /* opkind_StoreLocal */
+			/* We don't add localsbase here; the store address for desttype 2
+			   is relative to the current locals segment, not an absolute
+			   stack position. */
+			curarg->desttype = 2;
+			curarg->value = arg;
+			break;
+		}
 	}
 }
 
@@ -21,18 +21,35 @@
  */
 
 #include "glk/glulxe/glulxe.h"
+#include "common/config-manager.h"
+#include "common/system.h"
 
 namespace Glk {
 namespace Glulxe {
 
 #define IFFID(c1, c2, c3, c4) MKTAG(c1, c2, c3, c4)
 
+/* The largest undo_budget setting accepted, in kilobytes */
+#define MAX_UNDO_BUDGET (256 * 1024)
+
 bool Glulxe::init_serial() {
 	undo_chain_num = 0;
 	undo_chain_size = max_undo_level;
 	undo_chain = (unsigned char **)glulx_malloc(sizeof(unsigned char *) * undo_chain_size);
-	if (!undo_chain)
+	undo_chain_lens = (uint *)glulx_malloc(sizeof(uint) * undo_chain_size);
+	if (!undo_chain || !undo_chain_lens)
 		return false;
+	undo_chain_bytes = 0;
+
+	// The undo budget can be overridden in kilobytes
+	if (ConfMan.hasKey("undo_budget")) {
+		int budget = ConfMan.getInt("undo_budget");
+		if (budget < 0 || budget > MAX_UNDO_BUDGET) {
+			budget = CLIP(budget, 0, MAX_UNDO_BUDGET);
+			warning("undo_budget must be between 0 and %d KB, using %d KB", MAX_UNDO_BUDGET, budget);
+		}
+		max_undo_bytes = budget * 1024;
+	}
 
 #ifdef SERIALIZE_CACHE_RAM
 	{
@@ -64,6 +81,16 @@ void Glulxe::final_serial() {
 	undo_chain_size = 0;
 	undo_chain_num = 0;
 
+	glulx_free(undo_chain_lens);
+	undo_chain_lens = nullptr;
+	undo_chain_bytes = 0;
+
+	if (undo_ram) {
+		glulx_free(undo_ram);
+		undo_ram = nullptr;
+	}
+	undo_ram_len = undo_ram_size = 0;
+
 #ifdef SERIALIZE_CACHE_RAM
 	if (ramcache) {
 		glulx_free(ramcache);
@@ -77,12 +104,14 @@ uint Glulxe::perform_saveundo() {
 	uint res;
 	uint memstart = 0, memlen = 0, heapstart = 0, heaplen = 0;
 	uint stackstart = 0, stacklen = 0;
+	uint32 startTime = g_system->getMillis();
 
 	/* The format for undo-saves is simpler than for saves on disk. We
 	   just have a memory chunk, a heap chunk, and a stack chunk, in
 	   that order. We skip the IFF chunk headers (although the size
 	   fields are still there.) We also don't bother with IFF's 16-bit
-	   alignment. */
+	   alignment. The memory chunk only holds the differences from the
+	   previous undo state, see write_undo_memstate(). */
 
 	if (undo_chain_size == 0)
 		return 1;
@@ -99,7 +128,7 @@ uint Glulxe::perform_saveundo() {
 	}
 	if (res == 0) {
 		memstart = dest.pos;
-		res = write_memstate(&dest);
+		res = write_undo_memstate(&dest);
 		memlen = dest.pos - memstart;
 	}
 	if (res == 0) {
@@ -146,28 +175,48 @@ uint Glulxe::perform_saveundo() {
 
 	if (res == 0) {
 		/* It worked. */
-		if (undo_chain_num >= undo_chain_size) {
-			glulx_free(undo_chain[undo_chain_num - 1]);
-			undo_chain[undo_chain_num - 1] = nullptr;
-		}
-		if (undo_chain_size > 1)
+		if (undo_chain_num >= undo_chain_size)
+			drop_oldest_undo();
+		if (undo_chain_size > 1) {
 			memmove(undo_chain + 1, undo_chain,
 			        (undo_chain_size - 1) * sizeof(unsigned char *));
+			memmove(undo_chain_lens + 1, undo_chain_lens,
+			        (undo_chain_size - 1) * sizeof(uint));
+		}
 		undo_chain[0] = dest.ptr;
-		if (undo_chain_num < undo_chain_size)
-			undo_chain_num += 1;
+		undo_chain_lens[0] = dest.pos;
+		undo_chain_bytes += dest.pos;
+		undo_chain_num += 1;
 		dest.ptr = nullptr;
+
+		while (undo_chain_num > 1 && undo_chain_bytes > max_undo_bytes)
+			drop_oldest_undo();
 	} else {
 		/* It didn't work. */
 		if (dest.ptr) {
 			glulx_free(dest.ptr);
 			dest.ptr = nullptr;
 		}
+
+		/* The copy of the newest state's RAM may have been partly
+		   updated, so the states relying on it are no use either. */
+		while (undo_chain_num > 0)
+			drop_oldest_undo();
 	}
 
+	debugC(kDebugCore, "saveundo took %ums, %d states using %u bytes",
+		g_system->getMillis() - startTime, undo_chain_num, undo_chain_bytes);
+
 	return res;
 }
 
+void Glulxe::drop_oldest_undo() {
+	undo_chain_num -= 1;
+	glulx_free(undo_chain[undo_chain_num]);
+	undo_chain[undo_chain_num] = nullptr;
+	undo_chain_bytes -= undo_chain_lens[undo_chain_num];
+}
+
 uint Glulxe::perform_restoreundo() {
 	dest_t dest;
 	uint res, val = 0;
@@ -194,7 +243,7 @@ uint Glulxe::perform_restoreundo() {
 		res = read_long(&dest, &val);
 	}
 	if (res == 0) {
-		res = read_memstate(&dest, val);
+		res = read_undo_memstate(&dest, val);
 	}
 	if (res == 0) {
 		res = read_long(&dest, &val);
@@ -217,10 +266,20 @@ uint Glulxe::perform_restoreundo() {
 	}
 
 	if (res == 0) {
-		/* It worked. */
-		if (undo_chain_size > 1)
+		/* It worked. Step the RAM copy back to the next older state,
+		   unless there isn't one. */
+		if (undo_chain_num > 1) {
+			apply_undo_delta(dest.ptr + 8, Read4(dest.ptr) - 4);
+			undo_ram_len = Read4(undo_chain[1] + 4) - ramstart;
+		}
+
+		undo_chain_bytes -= undo_chain_lens[0];
+		if (undo_chain_size > 1) {
 			memmove(undo_chain, undo_chain + 1,
 			        (undo_chain_size - 1) * sizeof(unsigned char *));
+			memmove(undo_chain_lens, undo_chain_lens + 1,
+			        (undo_chain_size - 1) * sizeof(uint));
+		}
 		undo_chain_num -= 1;
 		glulx_free(dest.ptr);
 		dest.ptr = nullptr;
@@ -630,6 +689,115 @@ uint Glulxe::write_memstate(dest_t *dest) {
 	return 0;
 }
 
+uint Glulxe::write_undo_memstate(dest_t *dest) {
+	uint res, pos, len, cmplen;
+	int val;
+	int runlen;
+	unsigned char ch;
+
+	res = write_long(dest, endmem);
+	if (res)
+		return res;
+
+	/* Bytes past the end of memory count as zero in both states, and the
+	   copy is kept zeroed past the end of its state to match. */
+	len = endmem - ramstart;
+	cmplen = MAX(len, undo_ram_len);
+	if (len > undo_ram_size) {
+		byte *ram = (byte *)glulx_realloc(undo_ram, len);
+		if (!ram)
+			return 1;
+		memset(ram + undo_ram_size, 0, len - undo_ram_size);
+		undo_ram = ram;
+		undo_ram_size = len;
+	}
+
+	if (undo_chain_num == 0) {
+		/* The oldest state never gets stepped back from, so it doesn't
+		   need a difference. */
+		memcpy(undo_ram, memmap + ramstart, len);
+		memset(undo_ram + len, 0, undo_ram_size - len);
+		undo_ram_len = len;
+		return 0;
+	}
+
+	runlen = 0;
+
+	for (pos = 0; pos < cmplen; pos++) {
+		ch = (pos < len) ? Mem1(ramstart + pos) : 0;
+		val = ch ^ undo_ram[pos];
+		undo_ram[pos] = ch;
+
+		if (val == 0) {
+			runlen++;
+		} else {
+			/* Write any run we've got. */
+			while (runlen) {
+				int run = (runlen >= 0x100) ? 0x100 : runlen;
+				res = write_byte(dest, 0);
+				if (res)
+					return res;
+				res = write_byte(dest, (run - 1));
+				if (res)
+					return res;
+				runlen -= run;
+			}
+			/* Write the byte we got. */
+			res = write_byte(dest, val);
+			if (res)
+				return res;
+		}
+	}
+	/* As with write_memstate, a run left over isn't written. */
+
+	undo_ram_len = len;
+	return 0;
+}
+
+uint Glulxe::read_undo_memstate(dest_t *dest, uint chunklen) {
+	uint chunkend = dest->pos + chunklen;
+	uint newlen;
+	uint res, pos;
+
+	heap_clear();
+
+	res = read_long(dest, &newlen);
+	if (res)
+		return res;
+	if (newlen - ramstart != undo_ram_len)
+		return 1;
+
+	res = change_memsize(newlen, false);
+	if (res)
+		return res;
+
+	for (pos = ramstart; pos < endmem; pos++) {
+		if (pos >= protectstart && pos < protectend)
+			continue;
+
+		MemW1(pos, undo_ram[pos - ramstart]);
+	}
+
+	/* The difference to the older state only gets applied once the
+	   whole undo has succeeded. */
+	dest->pos = chunkend;
+	return 0;
+}
+
+void Glulxe::apply_undo_delta(const byte *delta, uint len) {
+	const byte *end = delta + len;
+	byte *ram = undo_ram;
+
+	while (delta < end) {
+		if (*delta == 0) {
+			ram += delta[1] + 1;
+			delta += 2;
+		} else {
+			*ram++ ^= *delta++;
+		}
+	}
+}
+
 uint Glulxe::read_memstate(dest_t *dest, uint chunklen) {
 	uint chunkend = dest->pos + chunklen;
 	uint newlen;
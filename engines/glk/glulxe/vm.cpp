@@ -115,6 +115,10 @@ void Glulxe::finalize_vm() {
 		glulx_free(stack);
 		stack = nullptr;
 	}
+	if (decodecache) {
+		glulx_free(decodecache);
+		decodecache = nullptr;
+	}
 
 	final_serial();
 }
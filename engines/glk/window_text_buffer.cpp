@@ -41,8 +41,9 @@ TextBufferWindow::TextBufferWindow(Windows *windows, uint rock) : TextWindow(win
 		_lastSeen(0), _scrollPos(0), _scrollMax(0), _scrollBack(SCROLLBACK), _width(-1), _height(-1),
 		_inBuf(nullptr), _lineTerminators(nullptr), _echoLineInput(true), _ladjw(0), _radjw(0),
 		_ladjn(0), _radjn(0), _numChars(0), _chars(nullptr), _attrs(nullptr), _spaced(0), _dashed(0),
-		_copyBuf(0), _copyPos(0) {
+		_copyBuf(0), _copyPos(0), _lineWidthsValid(0) {
 	_type = wintype_TextBuffer;
+	_lineWidths[0] = 0;
 	_history.resize(HISTORYLEN);
 
 	_lines.resize(SCROLLBACK);
@@ -235,7 +236,8 @@ void TextBufferWindow::touchScroll() {
 	g_vm->_selection->clearSelection();
 	_windows->repaint(_bbox);
 
-	for (int i = 0; i < _scrollMax; i++)
+	// Rows outside the view get marked when scrolling brings them into it
+	for (int i = _scrollPos; i < _scrollMax && i < _scrollPos + _height; i++)
 		_lines[i]._dirty = true;
 }
 
@@ -304,6 +306,8 @@ void TextBufferWindow::putText(const char *buf, int len, int pos, int oldlen) {
 	if (_numChars + diff >= TBLINELEN)
 		return;
 
+	invalidateWidths(pos);
+
 	if (diff != 0 && pos + oldlen < _numChars) {
 		memmove(_chars + pos + len,
 				_chars + pos + oldlen,
@@ -336,6 +340,8 @@ void TextBufferWindow::putTextUni(const uint32 *buf, int len, int pos, int oldle
 	if (_numChars + diff >= TBLINELEN)
 		return;
 
+	invalidateWidths(pos);
+
 	if (diff != 0 && pos + oldlen < _numChars) {
 		memmove(_chars + pos + len,
 				_chars + pos + oldlen,
@@ -473,6 +479,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 		}
 	}
 
+	invalidateWidths(_numChars);
 	_chars[_numChars] = ch;
 	_attrs[_numChars] = _attr;
 	_numChars++;
@@ -484,7 +491,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 			&& !_styles[_attrs[linelen - 1].style].reverse)
 		linelen--;
 
-	if (calcWidth(_chars, _attrs, 0, linelen, -1) >= pw) {
+	if (lineWidth(linelen) >= pw) {
 		bpoint = _numChars;
 
 		for (i = _numChars - 1; i > 0; i--) {
@@ -552,11 +559,13 @@ void TextBufferWindow::clear() {
 		_lines[i]._newLine = 0;
 		_lines[i]._dirty = true;
 		_lines[i]._repaint = false;
+		_lines[i]._measuredLen = -1;
 	}
 
 	_lastSeen = 0;
 	_scrollPos = 0;
 	_scrollMax = 0;
+	invalidateWidths(0);
 
 	for (i = 0; i < _height; i++)
 		touch(i);
@@ -620,7 +629,7 @@ void TextBufferWindow::requestLineEvent(char *buf, uint maxlen, uint initlen) {
 	// make sure we have some space left for typing...
 	pw = (_bbox.right - _bbox.left - g_conf->_tMarginX * 2) * GLI_SUBPIX;
 	pw = pw - 2 * SLOP - _radjw + _ladjw;
-	if (calcWidth(_chars, _attrs, 0, _numChars, -1) >= pw * 3 / 4)
+	if (lineWidth(_numChars) >= pw * 3 / 4)
 		putCharUni('\n');
 
 	_inBuf = buf;
@@ -678,7 +687,7 @@ void TextBufferWindow::requestLineEventUni(uint32 *buf, uint maxlen, uint initle
 	// make sure we have some space left for typing...
 	pw = (_bbox.right - _bbox.left - g_conf->_tMarginX * 2) * GLI_SUBPIX;
 	pw = pw - 2 * SLOP - _radjw + _ladjw;
-	if (calcWidth(_chars, _attrs, 0, _numChars, -1) >= pw * 3 / 4)
+	if (lineWidth(_numChars) >= pw * 3 / 4)
 		putCharUni('\n');
 
 	//_lastSeen = 0;
@@ -814,6 +823,7 @@ void TextBufferWindow::redraw() {
 	int selrow, selchar, sx0, sx1, selleft, selright;
 	bool selBuf;
 	int tx, tsc, tsw, lsc, rsc;
+	TextBufferRow selectedRow;
 	Screen &screen = *g_vm->_screen;
 
 	Window::redraw();
@@ -849,7 +859,13 @@ void TextBufferWindow::redraw() {
 		if (selrow)
 			_lines[i]._dirty = true;
 
-		TextBufferRow ln(_lines[i]);
+		// Selected characters get their attributes reversed, so those rows are drawn from a copy
+		TextBufferRow *row = &_lines[i];
+		if (selrow && !Windows::_claimSelect) {
+			selectedRow = *row;
+			row = &selectedRow;
+		}
+		TextBufferRow &ln = *row;
 
 		// skip if we can
 		if (!ln._dirty && !ln._repaint && !Windows::_forceRedraw && _scrollPos == 0)
@@ -882,7 +898,7 @@ void TextBufferWindow::redraw() {
 			linelen --;
 
 		// kill characters that would overwrite the scroll bar
-		while (linelen > 1 && calcWidth(ln._chars, ln._attrs, 0, linelen, -1) >= pw)
+		while (linelen > 1 && rowWidth(i, linelen) >= pw)
 			linelen --;
 
 		/*
@@ -892,7 +908,7 @@ void TextBufferWindow::redraw() {
 			for (a = 0, nsp = 0; a < linelen; a++)
 				if (ln._chars[a] == ' ')
 					nsp ++;
-			w = calcWidth(ln._chars, ln._attrs, 0, linelen, 0);
+			w = rowWidth(i, linelen);
 			if (nsp)
 				spw = (x1 - x0 - ln._lm - ln._rm - 2 * SLOP - w) / nsp;
 			else
@@ -1014,7 +1030,7 @@ void TextBufferWindow::redraw() {
 		 */
 
 		if (_windows->getFocusWindow() == this && i == 0 && (_lineRequest || _lineRequestUni)) {
-			w = calcWidth(_chars, _attrs, 0, _inCurs, spw);
+			w = lineWidth(_inCurs);
 			if (w < pw - _font._caretShape * 2 * GLI_SUBPIX)
 				_font.drawCaret(Point(x0 + SLOP + ln._lm + w, y + _font._baseLine));
 		}
@@ -1080,7 +1096,7 @@ void TextBufferWindow::redraw() {
 	 * draw the images
 	 */
 	for (i = 0; i < _scrollBack; i++) {
-		TextBufferRow ln(_lines[i]);
+		const TextBufferRow &ln = _lines[i];
 
 		y = y0 + (_height - (i - _scrollPos) - 1) * _font._leading;
 
@@ -1540,11 +1556,17 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._len = _numChars;
 	_lines[0]._newLine = forced;
 
-	for (int i = _scrollBack - 1; i > 0; i--) {
-		memcpy(&_lines[i], &_lines[i - 1], sizeof(TextBufferRow));
-		if (i < _height)
-			touch(i);
-	}
+	// The oldest row is recycled as the new current line
+	_lines.rotate();
+	_chars = _lines[0]._chars;
+	_attrs = _lines[0]._attrs;
+	if (_lines[0]._lPic)
+		_lines[0]._lPic->decrement();
+	if (_lines[0]._rPic)
+		_lines[0]._rPic->decrement();
+
+	for (int i = 1; i < _height && i < _scrollBack; i++)
+		touch(i);
 
 	if (_radjn)
 		_radjn--;
@@ -1564,42 +1586,27 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._rPic = nullptr;
 	_lines[0]._lHyper = 0;
 	_lines[0]._rHyper = 0;
-	
+	_lines[0]._measuredLen = -1;
+
 	Common::fill(_chars, _chars + TBLINELEN, ' ');
 	Attributes *a = _attrs;
 	for (int i = 0; i < TBLINELEN; ++i, ++a)
 		a->clear();
 
 	_numChars = 0;
+	invalidateWidths(0);
 
 	touchScroll();
 
 }
 
 void TextBufferWindow::scrollResize() {
-	int i;
-
-	_lines.clear();
+	// Existing rows are kept, and the new ones start out empty
 	_lines.resize(_scrollBack + SCROLLBACK);
 
 	_chars = _lines[0]._chars;
 	_attrs = _lines[0]._attrs;
 
-	for (i = _scrollBack; i < (_scrollBack + SCROLLBACK); i++) {
-		_lines[i]._dirty = false;
-		_lines[i]._repaint = false;
-		_lines[i]._lm = 0;
-		_lines[i]._rm = 0;
-		_lines[i]._lPic = 0;
-		_lines[i]._rPic = 0;
-		_lines[i]._lHyper = 0;
-		_lines[i]._rHyper = 0;
-		_lines[i]._len = 0;
-		_lines[i]._newLine = 0;
-		memset(_lines[i]._chars, ' ', sizeof _lines[i]._chars);
-		memset(_lines[i]._attrs, 0, sizeof _lines[i]._attrs);
-	}
-
 	_scrollBack += SCROLLBACK;
 }
 
@@ -1622,6 +1629,42 @@ int TextBufferWindow::calcWidth(const uint32 *chars, const Attributes *attrs, in
 	return w;
 }
 
+int TextBufferWindow::lineWidth(int numChars) {
+	Screen &screen = *g_vm->_screen;
+
+	// A character continuing an attribute run adds its own width plus any kerning
+	// against the previous character, which is what calcWidth would add for it
+	while (_lineWidthsValid < numChars) {
+		int i = _lineWidthsValid;
+		int font = _attrs[i].attrFont(_styles);
+		int w;
+
+		if (i > 0 && _attrs[i - 1] == _attrs[i])
+			w = screen.stringWidthUni(font, Common::U32String(_chars + i - 1, 2))
+				- screen.stringWidthUni(font, Common::U32String(_chars + i - 1, 1));
+		else
+			w = screen.stringWidthUni(font, Common::U32String(_chars + i, 1));
+
+		_lineWidths[i + 1] = _lineWidths[i] + w;
+		_lineWidthsValid++;
+	}
+
+	return _lineWidths[numChars];
+}
+
+int TextBufferWindow::rowWidth(int line, int numChars) {
+	if (line == 0)
+		return lineWidth(numChars);
+
+	TextBufferRow &ln = _lines[line];
+	if (ln._measuredLen != numChars) {
+		ln._measuredWidth = calcWidth(ln._chars, ln._attrs, 0, numChars, -1);
+		ln._measuredLen = numChars;
+	}
+
+	return ln._measuredWidth;
+}
+
 void TextBufferWindow::getSize(uint *width, uint *height) const {
 	if (width)
 		*width = (_bbox.width() - g_conf->_tMarginX * 2) / _font._cellW;
@@ -1638,8 +1681,25 @@ void TextBufferWindow::flowBreak() {
 
 TextBufferWindow::TextBufferRow::TextBufferRow() : _len(0), _newLine(0), _dirty(false),
 	_repaint(false), _lPic(nullptr), _rPic(nullptr), _lHyper(0), _rHyper(0),
-	_lm(0), _rm(0) {
+	_lm(0), _rm(0), _measuredLen(-1), _measuredWidth(0) {
 	Common::fill(&_chars[0], &_chars[TBLINELEN], 0);
 }
 
+/*--------------------------------------------------------------------------*/
+
+void TextBufferWindow::TextBufferRows::resize(uint newSize) {
+	if (_first) {
+		// Unwind the ring, so the new rows get added after the oldest one
+		Common::Array<TextBufferRow> rows;
+		rows.reserve(newSize);
+		for (uint idx = 0; idx < _rows.size(); ++idx)
+			rows.push_back((*this)[idx]);
+
+		_rows = rows;
+		_first = 0;
+	}
+
+	_rows.resize(newSize);
+}
+
 } // End of namespace Glk
@@ -47,13 +47,42 @@ class TextBufferWindow : public TextWindow, Speech {
 		Picture *_lPic, *_rPic;
 		uint _lHyper, _rHyper;
 		int _lm, _rm;
+		int _measuredLen, _measuredWidth;  ///< cached width of the first _measuredLen chars
 
 		/**
 		 * Constructor
 		 */
 		TextBufferRow();
 	};
-	typedef Common::Array<TextBufferRow> TextBufferRows;
+
+	/**
+	 * Scrollback rows, with row 0 being the current line. The rows are kept in a ring,
+	 * so scrolling a line into the scrollback only moves the start of the ring rather
+	 * than copying every row down by one
+	 */
+	class TextBufferRows {
+	private:
+		Common::Array<TextBufferRow> _rows;
+		uint _first;
+	public:
+		TextBufferRows() : _first(0) {}
+
+		uint size() const { return _rows.size(); }
+
+		TextBufferRow &operator[](uint idx) { return _rows[(_first + idx) % _rows.size()]; }
+
+		const TextBufferRow &operator[](uint idx) const { return _rows[(_first + idx) % _rows.size()]; }
+
+		/**
+		 * Grow the number of rows, keeping the existing rows in order
+		 */
+		void resize(uint newSize);
+
+		/**
+		 * Move every row back by one, making the oldest row the new row 0
+		 */
+		void rotate() { _first = (_first + _rows.size() - 1) % _rows.size(); }
+	};
 private:
 	PropFontInfo &_font;
 private:
@@ -92,6 +121,25 @@ private:
 	void scrollOneLine(bool forced);
 	void scrollResize();
 	int calcWidth(const uint32 *chars, const Attributes *attrs, int startchar, int numchars, int spw);
+
+	/**
+	 * Returns the width of the first numChars characters of the current line,
+	 * measuring only the characters added since the last call
+	 */
+	int lineWidth(int numChars);
+
+	/**
+	 * Returns the width of the first numChars characters of a given row
+	 */
+	int rowWidth(int line, int numChars);
+
+	/**
+	 * Discard the cached widths of the current line from a given character onwards
+	 */
+	void invalidateWidths(int pos) {
+		if (_lineWidthsValid > pos)
+			_lineWidthsValid = pos;
+	}
 public:
 	int _width, _height;
 	int _spaced;
@@ -103,6 +151,8 @@ public:
 	int _numChars;        ///< number of chars in last line: lines[0]
 	uint32 *_chars;       ///< alias to lines[0].chars
 	Attributes *_attrs;   ///< alias to lines[0].attrs
+	int _lineWidths[TBLINELEN + 1];  ///< widths of each prefix of lines[0]
+	int _lineWidthsValid; ///< number of chars covered by _lineWidths
 
 	///< adjust margins temporarily for images
 	int _ladjw;
@@ -100,6 +100,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("selectors",			WRAP_METHOD(Console, cmdSelectors));
 	registerCmd("functions",			WRAP_METHOD(Console, cmdKernelFunctions));
 	registerCmd("class_table",		WRAP_METHOD(Console, cmdClassTable));
+	registerCmd("path_bench",			WRAP_METHOD(Console, cmdPathBench));
 	// Parser
 	registerCmd("suffixes",			WRAP_METHOD(Console, cmdSuffixes));
 	registerCmd("parse_grammar",		WRAP_METHOD(Console, cmdParseGrammar));
@@ -117,6 +118,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
+	registerCmd("resource_cache_stats",	WRAP_METHOD(Console, cmdResourceCacheStats));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	registerCmd("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
 	registerCmd("integrity_dump",	WRAP_METHOD(Console, cmdResourceIntegrityDump));
@@ -319,6 +321,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" selector - Attempts to find the requested selector by name\n");
 	debugPrintf(" functions - Lists the kernel functions\n");
 	debugPrintf(" class_table - Shows the available classes\n");
+	debugPrintf(" path_bench - Records pathfinding calls and times them with and without the visibility graph cache\n");
 	debugPrintf("\n");
 	debugPrintf("Parser:\n");
 	debugPrintf(" suffixes - Lists the vocabulary suffixes\n");
@@ -338,6 +341,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_types - Shows the valid resource types\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
+	debugPrintf(" resource_cache_stats - Shows resource cache usage and statistics for the current room\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	debugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
 	debugPrintf(" integrity_dump - Dumps integrity data about resources in the current game to disk\n");
@@ -998,6 +1002,21 @@ bool Console::cmdResourceIntegrityDump(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCacheStats(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+	const ResourceCacheStats &stats = resMan->getCacheStats();
+
+	debugPrintf("Cache: %d of %d bytes used (%d protected), %d bytes locked\n",
+				resMan->getMemoryLRU(), resMan->getMaxMemoryLRU(),
+				resMan->getMemoryProtectedLRU(), resMan->getMemoryLocked());
+	debugPrintf("Room %d: %u hits, %u misses, %u bytes read\n",
+				resMan->getCacheRoomNumber(), stats.hits, stats.misses, stats.bytesRead);
+	debugPrintf("Prefetch: %u resources loaded, %u used, %u still queued\n",
+				stats.prefetched, stats.prefetchHits, resMan->getPrefetchQueueSize());
+
+	return true;
+}
+
 bool Console::cmdAllocList(int argc, const char **argv) {
 	ResourceManager *resMan = _engine->getResMan();
 
@@ -1668,6 +1687,81 @@ bool Console::cmdClassTable(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdPathBench(int argc, const char **argv) {
+	EngineState *s = _engine->_gamestate;
+
+	if (argc == 3 && !scumm_stricmp(argv[1], "record")) {
+		if (!scumm_stricmp(argv[2], "on")) {
+			s->_avoidPathRecording = true;
+			debugPrintf("Recording kAvoidPath calls\n");
+			return true;
+		} else if (!scumm_stricmp(argv[2], "off")) {
+			s->_avoidPathRecording = false;
+			debugPrintf("No longer recording kAvoidPath calls\n");
+			return true;
+		}
+	}
+
+	if (argc > 2) {
+		debugPrintf("Runs the most recent kAvoidPath calls again, with and without the\n");
+		debugPrintf("visibility graph cache and edge grid, and compares the paths found.\n");
+		debugPrintf("Calls are recorded while recording is on or the Pathfinding debug\n");
+		debugPrintf("channel is enabled.\n");
+		debugPrintf("Usage: %s [<rounds>]\n", argv[0]);
+		debugPrintf("       %s record on|off\n", argv[0]);
+		return true;
+	}
+
+	const int rounds = argc == 2 ? atoi(argv[1]) : 10;
+	const Common::Array<AvoidPathRecord> &log = s->_avoidPathLog;
+
+	if (log.empty()) {
+		debugPrintf("No kAvoidPath calls recorded, use \"%s record on\" first\n", argv[0]);
+		return true;
+	}
+
+	if (rounds <= 0) {
+		debugPrintf("Nothing to do\n");
+		return true;
+	}
+
+	// Start from an empty cache, and put the game's cache back afterwards
+	const Common::Array<AvoidPathCacheEntry> savedCache = s->_avoidPathCache;
+	s->_avoidPathCache.clear();
+	const uint32 savedCacheCounter = s->_avoidPathCacheCounter;
+
+	Common::Array<Common::Array<Common::Point> > paths[2];
+	uint32 time[2];
+	for (int pass = 0; pass < 2; ++pass) {
+		const bool optimized = pass == 1;
+		Common::Array<Common::Point> path;
+		paths[pass].resize(log.size());
+
+		const uint32 startTime = g_system->getMillis();
+		for (int round = 0; round < rounds; ++round) {
+			for (uint i = 0; i < log.size(); ++i) {
+				replayAvoidPath(s, log[i], optimized, path);
+				if (round == 0)
+					paths[pass][i] = path;
+			}
+		}
+		time[pass] = g_system->getMillis() - startTime;
+	}
+
+	s->_avoidPathCache = savedCache;
+	s->_avoidPathCacheCounter = savedCacheCounter;
+
+	int mismatches = 0;
+	for (uint i = 0; i < log.size(); ++i) {
+		if (paths[0][i] != paths[1][i])
+			++mismatches;
+	}
+
+	debugPrintf("%u calls, %d rounds: %u ms checking every edge, %u ms with the cache and edge grid\n", log.size(), rounds, time[0], time[1]);
+	debugPrintf("%d calls found different paths\n", mismatches);
+	return true;
+}
+
 bool Console::cmdSentenceFragments(int argc, const char **argv) {
 	debugPrintf("Sentence fragments (used to build Parse trees)\n");
 
@@ -38,6 +38,7 @@ struct Node;	// from segment.h
 struct List;	// from segment.h
 struct SelectorCache;	// from selector.h
 struct SciWorkaroundEntry;	// from workarounds.h
+struct AvoidPathRecord;	// from state.h
 
 /**
  * @defgroup VocabularyResources	Vocabulary resources in SCI
@@ -732,6 +733,18 @@ reg_t kFileIOIsValidDirectory(EngineState *s, int argc, reg_t *argv);
 
 //@}
 
+/**
+ * Runs the pathfinding of a kAvoidPath call recorded in the engine state
+ * again, without touching the game's memory.
+ * @param s				the game state
+ * @param record		the recorded call
+ * @param optimized		false to check visibility without the visibility
+ *						graph cache and the edge grid
+ * @param path			receives the points kAvoidPath returned for the call
+ * @return false if the start or end point couldn't be fixed up
+ */
+bool replayAvoidPath(EngineState *s, const AvoidPathRecord &record, bool optimized, Common::Array<Common::Point> &path);
+
 } // End of namespace Sci
 
 #endif // SCI_ENGINE_KERNEL_H
@@ -67,6 +67,12 @@ enum {
 
 #define HUGE_DISTANCE 0xFFFFFFFF
 
+// Polygon sets with more vertices than this don't get their visibility graph
+// cached, to keep the memory used by the cache bounded
+enum {
+	kMaxCachedVertices = 1024
+};
+
 #define VERTEX_HAS_EDGES(V) ((V) != CLIST_NEXT(V))
 
 // Error codes
@@ -117,10 +123,15 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Index in the polygon set before the start and end points were merged
+	// into it, or -1 for vertices which were added for these points
+	int staticIndex;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		staticIndex = -1;
 	}
 };
 
@@ -242,6 +253,108 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+/**
+ * Uniform grid over the polygon edges. Only edges with a bounding box that
+ * overlaps the bounding box of a line segment can obstruct that segment, so
+ * visibility checks only need to look at the edges in the covered cells.
+ */
+class EdgeGrid {
+public:
+	EdgeGrid() : _left(0), _top(0), _columns(0), _rows(0), _stamp(0) {}
+
+	/**
+	 * Registers the edges starting at the given vertices in the grid.
+	 * Single-vertex polygons have no edges and are skipped.
+	 */
+	void build(Vertex **vertices, int count) {
+		_cells.clear();
+		_edgeStamps.clear();
+		_columns = _rows = 0;
+
+		if (count == 0)
+			return;
+
+		int16 right, bottom;
+		_left = right = vertices[0]->v.x;
+		_top = bottom = vertices[0]->v.y;
+		for (int i = 1; i < count; i++) {
+			const Common::Point &p = vertices[i]->v;
+			_left = MIN(_left, p.x);
+			_top = MIN(_top, p.y);
+			right = MAX(right, p.x);
+			bottom = MAX(bottom, p.y);
+		}
+
+		_columns = (right - _left) / kCellSize + 1;
+		_rows = (bottom - _top) / kCellSize + 1;
+		_cells.resize(_columns * _rows);
+		_edgeStamps.resize(count);
+		_stamp = 0;
+
+		for (int i = 0; i < count; i++) {
+			Vertex *edge = vertices[i];
+			if (!VERTEX_HAS_EDGES(edge))
+				continue;
+
+			int x1, y1, x2, y2;
+			getCellRange(edge->v, CLIST_NEXT(edge)->v, x1, y1, x2, y2);
+			for (int y = y1; y <= y2; y++) {
+				for (int x = x1; x <= x2; x++)
+					_cells[y * _columns + x].push_back(i);
+			}
+		}
+	}
+
+	/**
+	 * Collects the indices of all edges which may intersect the line
+	 * segment (a, b). Each edge is returned only once.
+	 */
+	void findEdges(const Common::Point &a, const Common::Point &b, Common::Array<int> &edges) {
+		edges.clear();
+
+		if (_cells.empty())
+			return;
+
+		if (++_stamp == 0) {
+			for (uint i = 0; i < _edgeStamps.size(); i++)
+				_edgeStamps[i] = 0;
+			_stamp = 1;
+		}
+
+		int x1, y1, x2, y2;
+		getCellRange(a, b, x1, y1, x2, y2);
+		for (int y = y1; y <= y2; y++) {
+			for (int x = x1; x <= x2; x++) {
+				const Common::Array<int> &cell = _cells[y * _columns + x];
+				for (uint i = 0; i < cell.size(); i++) {
+					if (_edgeStamps[cell[i]] != _stamp) {
+						_edgeStamps[cell[i]] = _stamp;
+						edges.push_back(cell[i]);
+					}
+				}
+			}
+		}
+	}
+
+private:
+	enum {
+		kCellSize = 32
+	};
+
+	void getCellRange(const Common::Point &a, const Common::Point &b, int &x1, int &y1, int &x2, int &y2) const {
+		x1 = CLIP<int>((MIN(a.x, b.x) - _left) / kCellSize, 0, _columns - 1);
+		y1 = CLIP<int>((MIN(a.y, b.y) - _top) / kCellSize, 0, _rows - 1);
+		x2 = CLIP<int>((MAX(a.x, b.x) - _left) / kCellSize, 0, _columns - 1);
+		y2 = CLIP<int>((MAX(a.y, b.y) - _top) / kCellSize, 0, _rows - 1);
+	}
+
+	int16 _left, _top;
+	int _columns, _rows;
+	Common::Array<Common::Array<int> > _cells;
+	Common::Array<uint32> _edgeStamps;
+	uint32 _stamp;
+};
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
@@ -263,6 +376,19 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Spatial index of the edges in vertex_index
+	EdgeGrid _edgeGrid;
+	Common::Array<int> _edgeCandidates;
+
+	// Cached visibility between the vertices of the polygon set, or NULL
+	AvoidPathCacheEntry *_cacheEntry;
+
+	// Set when merging the start or end point split up an existing edge
+	bool _edgeSplit;
+
+	// Cleared to check visibility against every edge, as before the grid
+	bool _useEdgeGrid;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = NULL;
 		vertex_end = NULL;
@@ -270,6 +396,9 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		_cacheEntry = NULL;
+		_edgeSplit = false;
+		_useEdgeGrid = true;
 	}
 
 	~PathfindingState() {
@@ -699,6 +828,47 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Determines whether two vertices can see each other.
+ * @param s				the pathfinding state
+ * @param vertex_cur	the first vertex
+ * @param vertex		the second vertex
+ * @return true if the line between the vertices is unobstructed
+ */
+static bool is_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	// Check for intersecting edges
+	if (s->_useEdgeGrid) {
+		s->_edgeGrid.findEdges(vertex_cur->v, vertex->v, s->_edgeCandidates);
+	} else {
+		s->_edgeCandidates.clear();
+		for (int j = 0; j < s->vertices; j++) {
+			if (VERTEX_HAS_EDGES(s->vertex_index[j]))
+				s->_edgeCandidates.push_back(j);
+		}
+	}
+
+	for (uint j = 0; j < s->_edgeCandidates.size(); j++) {
+		Vertex *edge = s->vertex_index[s->_edgeCandidates[j]];
+		if (between(vertex_cur->v, vertex->v, edge->v)) {
+			// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+			if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
+				return false;
+
+			// This edge won't properly intersect, so we continue
+			continue;
+		}
+
+		if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+			return false;
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -707,34 +877,37 @@ static int inside(const Common::Point &p, Vertex *vertex) {
  */
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	VertexList *visVerts = new VertexList();
+	AvoidPathCacheEntry *cache = s->_cacheEntry;
+	const int row = cache ? vertex_cur->staticIndex : -1;
+
+	// Visibility between the vertices of the polygon set is computed once
+	// and then looked up in the cache. Only lines of sight to the start
+	// and end points need to be checked every time.
+	if (row >= 0 && !cache->rowComputed[row]) {
+		for (int i = 0; i < s->vertices; i++) {
+			Vertex *vertex = s->vertex_index[i];
+
+			if (vertex->staticIndex >= 0 && is_visible(s, vertex_cur, vertex)) {
+				const uint bit = row * cache->vertexCount + vertex->staticIndex;
+				cache->visibility[bit >> 5] |= 1 << (bit & 31);
+			}
+		}
+
+		cache->rowComputed[row] = true;
+	}
 
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
+		bool visible;
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
-			continue;
-
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
-
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
-			}
+		if (row >= 0 && vertex->staticIndex >= 0) {
+			const uint bit = row * cache->vertexCount + vertex->staticIndex;
+			visible = (cache->visibility[bit >> 5] & (1 << (bit & 31))) != 0;
+		} else {
+			visible = is_visible(s, vertex_cur, vertex);
 		}
 
-		if (j == s->vertices)
+		if (visible)
 			visVerts->push_front(vertex);
 	}
 
@@ -1129,6 +1302,7 @@ static Vertex *merge_point(PathfindingState *s, const Common::Point &v) {
 				if (between(vertex->v, next->v, v)) {
 					// Split edge by adding vertex
 					polygon->vertices.insertAfter(vertex, v_new);
+					s->_edgeSplit = true;
 					return v_new;
 				}
 			}
@@ -1207,6 +1381,50 @@ static Polygon *convert_polygon(EngineState *s, reg_t polygon) {
 	return poly;
 }
 
+/**
+ * Looks up the cached visibility graph for a polygon set, or sets up a new
+ * cache entry for it, replacing the least recently used one.
+ * @param s				the game state
+ * @param signature		vertex counts and coordinates of the polygon set
+ * @param vertexCount	total number of vertices in the polygon set
+ * @return the cache entry
+ */
+static AvoidPathCacheEntry *find_cache_entry(EngineState *s, const Common::Array<int16> &signature, uint vertexCount) {
+	Common::Array<AvoidPathCacheEntry> &cache = s->_avoidPathCache;
+	AvoidPathCacheEntry *entry = NULL;
+
+	++s->_avoidPathCacheCounter;
+
+	for (uint i = 0; i < cache.size(); i++) {
+		if (cache[i].signature == signature) {
+			debugC(kDebugLevelAvoidPath, "AvoidPath: Reusing visibility graph of %d vertices", vertexCount);
+			cache[i].lastUsed = s->_avoidPathCacheCounter;
+			return &cache[i];
+		}
+	}
+
+	if (cache.size() < EngineState::kAvoidPathCacheSize) {
+		cache.push_back(AvoidPathCacheEntry());
+		entry = &cache.back();
+	} else {
+		entry = &cache[0];
+		for (uint i = 1; i < cache.size(); i++) {
+			if (cache[i].lastUsed < entry->lastUsed)
+				entry = &cache[i];
+		}
+	}
+
+	entry->signature = signature;
+	entry->vertexCount = vertexCount;
+	entry->lastUsed = s->_avoidPathCacheCounter;
+	entry->visibility.clear();
+	entry->visibility.resize((vertexCount * vertexCount + 31) / 32);
+	entry->rowComputed.clear();
+	entry->rowComputed.resize(vertexCount);
+
+	return entry;
+}
+
 /**
  * Changes the polygon list for optimization level 0 (used for keyboard
  * support). Totally accessible polygons are removed and near-point
@@ -1232,40 +1450,53 @@ static void change_polygons_opt_0(PathfindingState *s) {
 }
 
 /**
- * Converts the SCI input data for pathfinding
- * Parameters: (EngineState *) s: The game state
- *             (reg_t) poly_list: Polygon list
- *             (Common::Point) start: The start point
- *             (Common::Point) end: The end point
- *             (int) opt: Optimization level (0, 1 or 2)
- * Returns   : (PathfindingState *) On success a newly allocated pathfinding state,
- *                            NULL otherwise
+ * Keeps a copy of the input of a kAvoidPath call in the log used by the
+ * path_bench debugger command.
  */
-static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Common::Point start, Common::Point end, int width, int height, int opt) {
-	SegManager *segMan = s->_segMan;
-	Polygon *polygon;
-	int count = 0;
-	PathfindingState *pf_s = new PathfindingState(width, height);
+static void record_polygon_set(EngineState *s, PathfindingState *pf_s, const Common::Point &start, const Common::Point &end, int opt) {
+	if (s->_avoidPathLog.size() < EngineState::kAvoidPathLogSize)
+		s->_avoidPathLog.push_back(AvoidPathRecord());
 
-	// Convert all polygons
-	if (poly_list.getSegment()) {
-		List *list = s->_segMan->lookupList(poly_list);
-		Node *node = s->_segMan->lookupNode(list->first);
-
-		while (node) {
-			// The node value might be null, in which case there's no polygon to parse.
-			// Happens in LB2 floppy - refer to bug #3041232
-			polygon = !node->value.isNull() ? convert_polygon(s, node->value) : NULL;
+	AvoidPathRecord &record = s->_avoidPathLog[s->_avoidPathLogNext];
+	s->_avoidPathLogNext = (s->_avoidPathLogNext + 1) % EngineState::kAvoidPathLogSize;
 
-			if (polygon) {
-				pf_s->polygons.push_back(polygon);
-				count += readSelectorValue(segMan, node->value, SELECTOR(size));
-			}
+	record.polygons.clear();
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it) {
+		Polygon *polygon = *it;
+		Vertex *vertex;
 
-			node = s->_segMan->lookupNode(node->succ);
+		record.polygons.push_back(polygon->type);
+		record.polygons.push_back(polygon->vertices.size());
+		CLIST_FOREACH(vertex, &polygon->vertices) {
+			record.polygons.push_back(vertex->v.x);
+			record.polygons.push_back(vertex->v.y);
 		}
 	}
 
+	record.start = start;
+	record.end = end;
+	record.width = pf_s->_width;
+	record.height = pf_s->_height;
+	record.opt = opt;
+}
+
+/**
+ * Applies the start and end point fixups to the converted polygons of a
+ * pathfinding state and merges these points into the polygon set.
+ * @param s			the game state
+ * @param pf_s		the pathfinding state holding the converted polygons
+ * @param count		upper bound for the number of polygon vertices
+ * @param start		the start point
+ * @param end		the end point
+ * @param opt		the optimization level
+ * @param optimized	false to neither use the visibility graph cache nor
+ *					the edge grid, to compare against
+ * @return the pathfinding state, or NULL on error, in which case pf_s has
+ *         been deleted
+ */
+static PathfindingState *prepare_polygon_set(EngineState *s, PathfindingState *pf_s, int count, Common::Point start, Common::Point end, int opt, bool optimized) {
+	Polygon *polygon;
+
 	if (opt == 0)
 		change_polygons_opt_0(pf_s);
 
@@ -1322,6 +1553,24 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	// Number the vertices of the polygon set before the start and end
+	// points are merged into it. The visibility between these vertices only
+	// depends on the polygon set, so it can be cached across calls.
+	Common::Array<int16> signature;
+	int staticCount = 0;
+
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it) {
+		polygon = *it;
+		Vertex *vertex;
+
+		signature.push_back(polygon->vertices.size());
+		CLIST_FOREACH(vertex, &polygon->vertices) {
+			vertex->staticIndex = staticCount++;
+			signature.push_back(vertex->v.x);
+			signature.push_back(vertex->v.y);
+		}
+	}
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
@@ -1329,6 +1578,11 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	delete new_start;
 	delete new_end;
 
+	// Splitting an edge changes the neighbours of its vertices, which
+	// affects the visibility checks, so the cache can't be used then
+	if (optimized && !pf_s->_edgeSplit && staticCount > 0 && staticCount <= kMaxCachedVertices)
+		pf_s->_cacheEntry = find_cache_entry(s, signature, staticCount);
+
 	// Allocate and build vertex index
 	pf_s->vertex_index = (Vertex**)malloc(sizeof(Vertex *) * (count + 2));
 
@@ -1344,10 +1598,54 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	}
 
 	pf_s->vertices = count;
+	pf_s->_useEdgeGrid = optimized;
+	if (optimized)
+		pf_s->_edgeGrid.build(pf_s->vertex_index, count);
 
 	return pf_s;
 }
 
+/**
+ * Converts the SCI input data for pathfinding
+ * Parameters: (EngineState *) s: The game state
+ *             (reg_t) poly_list: Polygon list
+ *             (Common::Point) start: The start point
+ *             (Common::Point) end: The end point
+ *             (int) opt: Optimization level (0, 1 or 2)
+ * Returns   : (PathfindingState *) On success a newly allocated pathfinding state,
+ *                            NULL otherwise
+ */
+static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Common::Point start, Common::Point end, int width, int height, int opt) {
+	SegManager *segMan = s->_segMan;
+	Polygon *polygon;
+	int count = 0;
+	PathfindingState *pf_s = new PathfindingState(width, height);
+
+	// Convert all polygons
+	if (poly_list.getSegment()) {
+		List *list = s->_segMan->lookupList(poly_list);
+		Node *node = s->_segMan->lookupNode(list->first);
+
+		while (node) {
+			// The node value might be null, in which case there's no polygon to parse.
+			// Happens in LB2 floppy - refer to bug #3041232
+			polygon = !node->value.isNull() ? convert_polygon(s, node->value) : NULL;
+
+			if (polygon) {
+				pf_s->polygons.push_back(polygon);
+				count += readSelectorValue(segMan, node->value, SELECTOR(size));
+			}
+
+			node = s->_segMan->lookupNode(node->succ);
+		}
+	}
+
+	if (s->_avoidPathRecording || DebugMan.isDebugChannelEnabled(kDebugLevelAvoidPath))
+		record_polygon_set(s, pf_s, start, end, opt);
+
+	return prepare_polygon_set(s, pf_s, count, start, end, opt, true);
+}
+
 /**
  * Computes a shortest path from vertex_start to vertex_end. The caller can
  * construct the resulting path by following the path_prev links from
@@ -1640,6 +1938,51 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 	}
 }
 
+bool replayAvoidPath(EngineState *s, const AvoidPathRecord &record, bool optimized, Common::Array<Common::Point> &path) {
+	PathfindingState *p = new PathfindingState(record.width, record.height);
+	int count = 0;
+
+	for (uint i = 0; i + 1 < record.polygons.size(); ) {
+		Polygon *polygon = new Polygon(record.polygons[i]);
+		const int size = record.polygons[i + 1];
+		i += 2;
+
+		for (int j = 0; j < size; j++, i += 2)
+			polygon->vertices.insertAtEnd(new Vertex(Common::Point(record.polygons[i], record.polygons[i + 1])));
+
+		p->polygons.push_back(polygon);
+		count += size;
+	}
+
+	p = prepare_polygon_set(s, p, count, record.start, record.end, record.opt, optimized);
+
+	path.clear();
+	if (!p)
+		return false;
+
+	AStar(p);
+
+	// Same points as output_path returns
+	if (p->_prependPoint)
+		path.push_back(*p->_prependPoint);
+
+	if (!p->vertex_end->path_prev) {
+		if (!p->_prependPoint)
+			path.push_back(p->vertex_start->v);
+		path.push_back(p->vertex_start->v);
+	} else {
+		const uint offset = path.size();
+		for (Vertex *vertex = p->vertex_end; vertex; vertex = vertex->path_prev)
+			path.insert_at(offset, vertex->v);
+
+		if (p->_appendPoint)
+			path.push_back(*p->_appendPoint);
+	}
+
+	delete p;
+	return true;
+}
+
 static bool PointInRect(const Common::Point &point, int16 rectX1, int16 rectY1, int16 rectX2, int16 rectY2) {
 	int16 top = MIN<int16>(rectY1, rectY2);
 	int16 left = MIN<int16>(rectX1, rectX2);
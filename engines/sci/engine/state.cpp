@@ -115,6 +115,12 @@ void EngineState::reset(bool isRestoring) {
 
 	_cursorWorkaroundActive = false;
 
+	_avoidPathCache.clear();
+	_avoidPathCacheCounter = 0;
+	_avoidPathLog.clear();
+	_avoidPathLogNext = 0;
+	_avoidPathRecording = false;
+
 	scriptStepCounter = 0;
 	scriptGCInterval = GC_INTERVAL;
 }
@@ -98,6 +98,34 @@ struct SciCallOrigin {
 	}
 };
 
+/**
+ * Visibility graph between the vertices of a polygon set used by kAvoidPath.
+ * Rows are computed lazily as vertices get expanded, and the whole entry is
+ * reused for as long as the game passes an identical polygon set.
+ */
+struct AvoidPathCacheEntry {
+	Common::Array<int16> signature; ///< Vertex counts and coordinates of all polygons
+	uint vertexCount;
+	Common::Array<uint32> visibility; ///< vertexCount x vertexCount bit matrix
+	Common::Array<bool> rowComputed;
+	uint32 lastUsed;
+
+	AvoidPathCacheEntry() : vertexCount(0), lastUsed(0) {}
+};
+
+/**
+ * Input of a kAvoidPath call, kept so that the pathfinding can be run again
+ * from the debugger after the game has disposed of its polygon list.
+ */
+struct AvoidPathRecord {
+	Common::Array<int16> polygons; ///< Type, vertex count and coordinates of each polygon
+	Common::Point start, end;
+	int16 width, height;
+	int opt;
+
+	AvoidPathRecord() : width(0), height(0), opt(0) {}
+};
+
 struct EngineState : public Common::Serializable {
 public:
 	EngineState(SegManager *segMan);
@@ -193,6 +221,24 @@ public:
 
 	MessageState *_msgState;
 
+	enum {
+		kAvoidPathCacheSize = 4
+	};
+	Common::Array<AvoidPathCacheEntry> _avoidPathCache;
+	uint32 _avoidPathCacheCounter;
+
+	/**
+	 * The most recent kAvoidPath calls, for the path_bench debugger command.
+	 * Calls are only recorded while _avoidPathRecording is set or the
+	 * Pathfinding debug channel is enabled.
+	 */
+	enum {
+		kAvoidPathLogSize = 64
+	};
+	Common::Array<AvoidPathRecord> _avoidPathLog;
+	uint _avoidPathLogNext;
+	bool _avoidPathRecording;
+
 	// MemorySegment provides access to a 256-byte block of memory that remains
 	// intact across restarts and restores
 	enum {
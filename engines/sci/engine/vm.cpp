@@ -201,6 +201,11 @@ static void write_var(EngineState *s, int type, int index, reg_t value) {
 
 		s->variables[type][index] = value;
 
+		// Let the resource manager know when the game switches rooms, so that
+		// it can prefetch the resources of the new room while the game idles
+		if (type == VAR_GLOBAL && index == kGlobalVarNewRoomNo && value.isNumber())
+			g_sci->getResMan()->notifyRoomChange(value.toUint16());
+
 		g_sci->_guestAdditions->writeVarHook(type, index, value);
 	}
 }
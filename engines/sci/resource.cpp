@@ -22,9 +22,11 @@
 
 // Resource library
 
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
@@ -46,6 +48,10 @@ enum {
 	SCI11_RESMAP_ENTRIES_SIZE = 5
 };
 
+enum {
+	kMaxResourceCacheSize = 1024 * 1024 ///< Largest resource_cache_size accepted, in KiB
+};
+
 /** resource type for SCI1 resource.map file */
 struct resource_index_t {
 	uint16 wOffset;
@@ -206,6 +212,8 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_fileOffset = 0;
 	_status = kResStatusNoMalloc;
 	_lockers = 0;
+	_referenced = false;
+	_prefetched = false;
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
@@ -222,6 +230,8 @@ void Resource::unalloc() {
 	delete[] _data;
 	_data = nullptr;
 	_status = kResStatusNoMalloc;
+	_referenced = false;
+	_prefetched = false;
 }
 
 void Resource::writeToStream(Common::WriteStream *stream) const {
@@ -972,7 +982,12 @@ void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
 	_memoryLRU = 0;
+	_memoryProtectedLRU = 0;
 	_LRU.clear();
+	_protectedLRU.clear();
+	_cacheRoomNumber = 0;
+	_prefetchEnabled = !_detectionMode;
+	_prefetchedBytes = 0;
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 #ifdef ENABLE_SCI32
@@ -1027,6 +1042,25 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	// Allow users with plenty of memory to keep more resources around, or
+	// users on very constrained systems to keep fewer
+	if (!_detectionMode) {
+		if (ConfMan.hasKey("resource_cache_size")) {
+			int cacheSize = ConfMan.getInt("resource_cache_size");
+			if (cacheSize > kMaxResourceCacheSize) {
+				warning("resource_cache_size of %d KiB is too large, using %d KiB", cacheSize, kMaxResourceCacheSize);
+				cacheSize = kMaxResourceCacheSize;
+			}
+			if (cacheSize > 0) {
+				_maxMemoryLRU = cacheSize * 1024;
+			}
+		}
+		if (ConfMan.hasKey("resource_prefetch")) {
+			_prefetchEnabled = ConfMan.getBool("resource_prefetch");
+		}
+		debugC(1, kDebugLevelResMan, "resMan: Resource cache size %d KiB, prefetching %s", _maxMemoryLRU / 1024, _prefetchEnabled ? "enabled" : "disabled");
+	}
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1073,7 +1107,12 @@ void ResourceManager::removeFromLRU(Resource *res) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
+	if (res->_referenced) {
+		_protectedLRU.remove(res);
+		_memoryProtectedLRU -= res->size();
+	} else {
+		_LRU.remove(res);
+	}
 	_memoryLRU -= res->size();
 	res->_status = kResStatusAllocated;
 }
@@ -1083,7 +1122,12 @@ void ResourceManager::addToLRU(Resource *res) {
 		warning("resMan: trying to enqueue resource with state %d", res->_status);
 		return;
 	}
-	_LRU.push_front(res);
+	if (res->_referenced) {
+		_protectedLRU.push_front(res);
+		_memoryProtectedLRU += res->size();
+	} else {
+		_LRU.push_front(res);
+	}
 	_memoryLRU += res->size();
 #if SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
@@ -1091,6 +1135,17 @@ void ResourceManager::addToLRU(Resource *res) {
 	      _memoryLRU);
 #endif
 	res->_status = kResStatusEnqueued;
+
+	// Keep some room in the cache for new resources by demoting the least
+	// recently used protected resources back to the probationary segment
+	const int maxMemoryProtectedLRU = _maxMemoryLRU - _maxMemoryLRU / 4;
+	while (_memoryProtectedLRU > maxMemoryProtectedLRU && _protectedLRU.size() > 1) {
+		Resource *demoted = _protectedLRU.back();
+		_protectedLRU.pop_back();
+		_memoryProtectedLRU -= demoted->size();
+		demoted->_referenced = false;
+		_LRU.push_front(demoted);
+	}
 }
 
 void ResourceManager::printLRU() {
@@ -1107,13 +1162,20 @@ void ResourceManager::printLRU() {
 		++it;
 	}
 
+	for (it = _protectedLRU.begin(); it != _protectedLRU.end(); ++it) {
+		res = *it;
+		debug("\t%s: %u bytes (protected)", res->_id.toString().c_str(), res->size());
+		mem += res->size();
+		++entries;
+	}
+
 	debug("Total: %d entries, %d bytes (mgr says %d)", entries, mem, _memoryLRU);
 }
 
 void ResourceManager::freeOldResources() {
 	while (_maxMemoryLRU < _memoryLRU) {
-		assert(!_LRU.empty());
-		Resource *goner = _LRU.back();
+		assert(!_LRU.empty() || !_protectedLRU.empty());
+		Resource *goner = !_LRU.empty() ? _LRU.back() : _protectedLRU.back();
 		removeFromLRU(goner);
 		goner->unalloc();
 #ifdef SCI_VERBOSE_RESMAN
@@ -1122,6 +1184,91 @@ void ResourceManager::freeOldResources() {
 	}
 }
 
+void ResourceManager::traceResource(const ResourceId &id) {
+	switch (id.getType()) {
+	case kResourceTypeView:
+	case kResourceTypePic:
+	case kResourceTypeSound:
+	case kResourceTypePalette:
+	case kResourceTypeAudio:
+		break;
+	default:
+		// Scripts are handled by the segment manager, and speech and sync
+		// resources are only used once, so there is no point in tracing them
+		return;
+	}
+
+	// Keep the trace of huge rooms within reasonable bounds
+	if (_currentRoomTrace.size() >= 256 || _currentRoomTraceSet.contains(id))
+		return;
+
+	_currentRoomTraceSet[id] = true;
+	_currentRoomTrace.push_back(id);
+}
+
+void ResourceManager::notifyRoomChange(uint16 roomNumber) {
+	if (roomNumber == _cacheRoomNumber)
+		return;
+
+	debugC(1, kDebugLevelResMan, "resMan: Leaving room %d: %u hits, %u misses, %u bytes read, %u/%u prefetched resources used",
+		   _cacheRoomNumber, _cacheStats.hits, _cacheStats.misses, _cacheStats.bytesRead,
+		   _cacheStats.prefetchHits, _cacheStats.prefetched);
+
+	if (!_currentRoomTrace.empty())
+		_roomTraces[_cacheRoomNumber] = _currentRoomTrace;
+
+	_cacheRoomNumber = roomNumber;
+	_cacheStats = ResourceCacheStats();
+	_currentRoomTrace.clear();
+	_currentRoomTraceSet.clear();
+	_prefetchQueue.clear();
+	_prefetchedBytes = 0;
+
+	if (!_prefetchEnabled)
+		return;
+
+	RoomTraceMap::const_iterator trace = _roomTraces.find(roomNumber);
+	if (trace == _roomTraces.end())
+		return;
+
+	for (uint i = 0; i < trace->_value.size(); ++i) {
+		const Resource *res = testResource(trace->_value[i]);
+		if (res && res->_status == kResStatusNoMalloc)
+			_prefetchQueue.push_back(trace->_value[i]);
+	}
+}
+
+bool ResourceManager::prefetchResources(uint32 deadline) {
+	bool loaded = false;
+
+	// Prefetching must never evict resources that are used by the room
+	// itself, so it stops once half of the cache has been filled with
+	// resources which were prefetched for this room. The count carries over
+	// between idle periods and is only reset when the room changes.
+	while (!_prefetchQueue.empty() && g_system->getMillis() < deadline && _prefetchedBytes < (uint32)_maxMemoryLRU / 2) {
+		const ResourceId id = _prefetchQueue.front();
+		_prefetchQueue.pop_front();
+
+		Resource *res = testResource(id);
+		if (!res || res->_status != kResStatusNoMalloc)
+			continue;
+
+		loadResource(res);
+		if (res->_status != kResStatusAllocated)
+			continue;
+
+		res->_prefetched = true;
+		_prefetchedBytes += res->size();
+		_cacheStats.prefetched++;
+		_cacheStats.bytesRead += res->size();
+		addToLRU(res);
+		freeOldResources();
+		loaded = true;
+	}
+
+	return loaded;
+}
+
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
 	Common::List<ResourceId> resources;
 
@@ -1147,15 +1294,33 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
-	if (retval->_status == kResStatusNoMalloc)
+	traceResource(id);
+
+	if (retval->_status == kResStatusNoMalloc) {
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+		_cacheStats.misses++;
+		_cacheStats.bytesRead += retval->size();
+	} else {
+		_cacheStats.hits++;
+
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
 		// will be added back to the LRU list at the 'most
 		// recent' position.
-		removeFromLRU(retval);
+		if (retval->_status == kResStatusEnqueued)
+			removeFromLRU(retval);
+
+		// Resources which are requested again while still in
+		// memory are moved to the protected segment. The first
+		// request of a prefetched resource does not count.
+		if (retval->_prefetched) {
+			_cacheStats.prefetchHits++;
+			retval->_prefetched = false;
+		} else {
+			retval->_referenced = true;
+		}
+	}
 
 	// Unless an error occurred, the resource is now either
 	// locked or allocated, but never queued or freed.
@@ -26,6 +26,7 @@
 #include "common/str.h"
 #include "common/list.h"
 #include "common/hashmap.h"
+#include "common/array.h"
 
 #include "sci/graphics/helpers.h"		// for ViewType
 #include "sci/decompressor.h"
@@ -296,6 +297,8 @@ protected:
 	int32 _fileOffset; /**< Offset in file */
 	ResourceStatus _status;
 	uint16 _lockers; /**< Number of places where this resource was locked */
+	bool _referenced; /**< Requested again while in memory, i.e. in the protected LRU segment */
+	bool _prefetched; /**< Loaded by the prefetcher and not requested since */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
@@ -310,6 +313,17 @@ protected:
 
 typedef Common::HashMap<ResourceId, Resource *, ResourceIdHash> ResourceMap;
 
+/** Resource cache counters, reset on every room change */
+struct ResourceCacheStats {
+	uint32 hits;         ///< Requests served from memory
+	uint32 misses;       ///< Requests which had to read from disk
+	uint32 bytesRead;    ///< Resource bytes loaded from disk, including prefetches
+	uint32 prefetched;   ///< Resources loaded ahead of time by the prefetcher
+	uint32 prefetchHits; ///< Prefetched resources which were requested afterwards
+
+	ResourceCacheStats() : hits(0), misses(0), bytesRead(0), prefetched(0), prefetchHits(0) {}
+};
+
 class IntMapResourceSource;
 class ResourceManager {
 	// FIXME: These 'friend' declarations are meant to be a temporary hack to
@@ -388,6 +402,31 @@ public:
 	 */
 	Common::List<ResourceId> listResources(ResourceType type, int mapNumber = -1);
 
+	/**
+	 * Notifies the resource manager that the game is switching to another
+	 * room. The resources which were requested during the previous visit of
+	 * the new room are queued for prefetching, and the cache statistics of
+	 * the room being left are reported and reset.
+	 * @param roomNumber	The number of the room being entered
+	 */
+	void notifyRoomChange(uint16 roomNumber);
+
+	/**
+	 * Loads queued prefetch resources until the queue is empty or the given
+	 * time has been reached. Meant to be called while the engine is idle.
+	 * @param deadline	Time (in g_system->getMillis() units) to stop at
+	 * @return true if any resource was loaded
+	 */
+	bool prefetchResources(uint32 deadline);
+
+	const ResourceCacheStats &getCacheStats() const { return _cacheStats; }
+	uint16 getCacheRoomNumber() const { return _cacheRoomNumber; }
+	int getMaxMemoryLRU() const { return _maxMemoryLRU; }
+	int getMemoryLRU() const { return _memoryLRU; }
+	int getMemoryProtectedLRU() const { return _memoryProtectedLRU; }
+	int getMemoryLocked() const { return _memoryLocked; }
+	uint getPrefetchQueueSize() const { return _prefetchQueue.size(); }
+
 	void setAudioLanguage(int language);
 	int getAudioLanguage() const;
 	void changeAudioDirectory(Common::String path);
@@ -479,7 +518,31 @@ protected:
 	SourcesList _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
-	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	int _memoryProtectedLRU; ///< Amount of resource bytes in the protected LRU segment
+	/**
+	 * Last Resource Used lists. The cache is a segmented LRU: resources enter
+	 * the probationary list (_LRU) when they are loaded, and only move to the
+	 * protected list once they are requested again while still in memory.
+	 * Eviction takes from the probationary list first, so a burst of
+	 * resources that are used only once (e.g. during a room change) cannot
+	 * flush the resources that are used over and over.
+	 */
+	Common::List<Resource *> _LRU;
+	Common::List<Resource *> _protectedLRU;
+
+	typedef Common::HashMap<ResourceId, bool, ResourceIdHash> ResourceIdSet;
+	typedef Common::HashMap<uint16, Common::Array<ResourceId> > RoomTraceMap;
+
+	uint16 _cacheRoomNumber; ///< Room the current statistics and trace belong to
+	ResourceCacheStats _cacheStats;
+	RoomTraceMap _roomTraces; ///< Resources requested during the last visit of each room
+	Common::Array<ResourceId> _currentRoomTrace;
+	ResourceIdSet _currentRoomTraceSet;
+	Common::List<ResourceId> _prefetchQueue;
+	bool _prefetchEnabled;
+	uint32 _prefetchedBytes; ///< Bytes prefetched since entering the current room
+
+	void traceResource(const ResourceId &id);
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -866,7 +866,10 @@ void SciEngine::sleep(uint32 msecs) {
 #endif
 		time = g_system->getMillis();
 		if (time + 10 < wakeUpTime) {
-			g_system->delayMillis(10);
+			// Use the idle time to load resources which the current room is
+			// expected to need, and only sleep if there is nothing to load
+			if (!_resMan->prefetchResources(wakeUpTime - 10))
+				g_system->delayMillis(10);
 		} else {
 			if (time < wakeUpTime)
 				g_system->delayMillis(wakeUpTime - time);
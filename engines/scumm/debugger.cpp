@@ -29,12 +29,23 @@
 #include "scumm/actor.h"
 #include "scumm/boxes.h"
 #include "scumm/debugger.h"
+#include "scumm/file.h"
 #include "scumm/imuse/imuse.h"
 #include "scumm/object.h"
 #include "scumm/resource.h"
 #include "scumm/scumm.h"
 #include "scumm/sound.h"
 
+#ifdef ENABLE_SCUMM_7_8
+#include "scumm/smush/codec47.h"
+#endif
+
+#ifdef ENABLE_HE
+#include "scumm/he/intern_he.h"
+#include "scumm/he/moonbase/moonbase.h"
+#include "scumm/he/moonbase/ai_main.h"
+#endif
+
 namespace Scumm {
 
 void debugC(int channel, const char *s, ...) {
@@ -97,6 +108,20 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("imuse",     WRAP_METHOD(ScummDebugger, Cmd_IMuse));
 
 	registerCmd("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
+
+	// The v1/v2, NES and PC Engine renderers do not use the strip decoders
+	if (_vm->_game.version >= 3 && _vm->_game.platform != Common::kPlatformNES && _vm->_game.platform != Common::kPlatformPCEngine)
+		registerCmd("strip_bench",  WRAP_METHOD(ScummDebugger, Cmd_StripBench));
+
+#ifdef ENABLE_SCUMM_7_8
+	if (_vm->_game.version >= 7)
+		registerCmd("san_bench",  WRAP_METHOD(ScummDebugger, Cmd_SanBench));
+#endif
+
+#ifdef ENABLE_HE
+	if (_vm->_game.id == GID_MOONBASE)
+		registerCmd("ai_stats",  WRAP_METHOD(ScummDebugger, Cmd_AIStats));
+#endif
 }
 
 ScummDebugger::~ScummDebugger() {
@@ -845,4 +870,201 @@ bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	return false;
 }
 
+bool ScummDebugger::Cmd_StripBench(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("Decodes the current room's background with both strip decoder paths and compares them\n");
+		debugPrintf("Usage: %s [<rounds>]\n", argv[0]);
+		return true;
+	}
+
+	const int rounds = (argc == 2) ? MAX(1, atoi(argv[1])) : 20;
+
+	byte *room;
+	if (_vm->_game.heversion >= 70)
+		room = _vm->getResourceAddress(rtRoomImage, _vm->_roomResource);
+	else
+		room = _vm->getResourceAddress(rtRoom, _vm->_roomResource);
+	if (!room) {
+		debugPrintf("No room loaded\n");
+		return true;
+	}
+
+	const int numStrips = _vm->_roomWidth / 8;
+	const int height = _vm->_roomHeight;
+	const int pitch = _vm->_roomWidth * _vm->_bytesPerPixel;
+	byte *buf = new byte[pitch * height];
+
+	static const char *const names[2] = { "generic", "inline palette" };
+	uint32 checksum[2] = { 0, 0 };
+	uint32 time[2];
+
+	for (int pass = 0; pass < 2; ++pass) {
+		const uint32 start = g_system->getMillis();
+		for (int i = 0; i < rounds; ++i) {
+			if (!_vm->_gdi->checksumStrips(room + _vm->_IM00_offs, buf, pitch, numStrips, height, pass == 1, checksum[pass])) {
+				debugPrintf("Room %d has no strip image\n", _vm->_roomResource);
+				delete[] buf;
+				return true;
+			}
+		}
+		time[pass] = g_system->getMillis() - start;
+	}
+
+	delete[] buf;
+
+	debugPrintf("Room %d, %d strips of %d lines, %d rounds\n", _vm->_roomResource, numStrips, height, rounds);
+	for (int pass = 0; pass < 2; ++pass)
+		debugPrintf("%-15s %5u ms, checksum %08x\n", names[pass], time[pass], checksum[pass]);
+	debugPrintf("%s\n", checksum[0] == checksum[1] ? "Checksums match" : "Checksums DIFFER");
+	return true;
+}
+
+#ifdef ENABLE_SCUMM_7_8
+bool ScummDebugger::Cmd_SanBench(int argc, const char **argv) {
+	if (argc < 2 || argc > 3) {
+		debugPrintf("Decodes the codec 47 frames of a SAN file directly and with read-ahead and compares them\n");
+		debugPrintf("Usage: %s <file> [<frames>]\n", argv[0]);
+		return true;
+	}
+
+	const uint maxFrames = (argc == 3) ? MAX(1, atoi(argv[2])) : 500;
+
+	ScummFile file;
+	if (!_vm->openFile(file, argv[1])) {
+		debugPrintf("Unable to open %s\n", argv[1]);
+		return true;
+	}
+
+	if (file.readUint32BE() != MKTAG('A','N','I','M')) {
+		debugPrintf("%s is not a SAN file\n", argv[1]);
+		return true;
+	}
+	const int32 fileSize = file.readUint32BE() + 8;
+
+	// Load the first codec 47 frame object of every frame up front, so that
+	// only decoding is timed
+	Common::Array<byte *> frames;
+	int width = 0, height = 0, skipped = 0;
+
+	while (frames.size() < maxFrames && file.pos() + 8 <= fileSize && !file.eos()) {
+		const uint32 type = file.readUint32BE();
+		const int32 size = file.readUint32BE();
+		const int32 end = file.pos() + size;
+		if (size < 0 || end > fileSize)
+			break;
+
+		if (type == MKTAG('F','R','M','E')) {
+			while (file.pos() + 8 <= end) {
+				const uint32 subType = file.readUint32BE();
+				const int32 subSize = file.readUint32BE();
+				const int32 subEnd = file.pos() + subSize;
+				if (subSize < 0 || subEnd > end)
+					break;
+
+				if (subType == MKTAG('Z','F','O','B')) {
+					skipped++;
+					break;
+				}
+
+				if (subType == MKTAG('F','O','B','J') && subSize > 14) {
+					const int codec = file.readUint16LE();
+					file.skip(4);
+					const int w = file.readUint16LE();
+					const int h = file.readUint16LE();
+					file.skip(4);
+
+					if (codec == 47 && (frames.empty() || (w == width && h == height))) {
+						width = w;
+						height = h;
+						byte *data = (byte *)malloc(subSize - 14);
+						file.read(data, subSize - 14);
+						frames.push_back(data);
+					}
+					break;
+				}
+
+				file.seek(subEnd + (subSize & 1), SEEK_SET);
+			}
+		}
+
+		file.seek(end, SEEK_SET);
+	}
+
+	if (frames.empty()) {
+		debugPrintf("%s has no codec 47 frames\n", argv[1]);
+		return true;
+	}
+
+	byte *dst = (byte *)malloc(width * height);
+	Common::Array<uint32> checksums;
+	uint32 time[2];
+	uint mismatches = 0, decodedAhead = 0;
+
+	for (int pass = 0; pass < 2; ++pass) {
+		Codec47Decoder decoder(width, height);
+
+		const uint32 start = g_system->getMillis();
+		for (uint i = 0; i < frames.size(); ++i) {
+			if (pass == 1 && decoder.decodeAhead(frames[i], width, height))
+				decodedAhead++;
+			decoder.decode(dst, frames[i]);
+
+			// FNV-1a
+			uint32 checksum = 2166136261U;
+			for (int j = 0; j < width * height; ++j)
+				checksum = (checksum ^ dst[j]) * 16777619U;
+
+			if (pass == 0)
+				checksums.push_back(checksum);
+			else if (checksum != checksums[i])
+				mismatches++;
+		}
+		time[pass] = g_system->getMillis() - start;
+	}
+
+	free(dst);
+	for (uint i = 0; i < frames.size(); ++i)
+		free(frames[i]);
+
+	uint32 total = 2166136261U;
+	for (uint i = 0; i < checksums.size(); ++i)
+		total = (total ^ checksums[i]) * 16777619U;
+
+	debugPrintf("%u frames of %dx%d", frames.size(), width, height);
+	if (skipped)
+		debugPrintf(", %d zlib compressed frames skipped", skipped);
+	debugPrintf("\n");
+	debugPrintf("direct     %5u ms\n", time[0]);
+	debugPrintf("read-ahead %5u ms, %u frames decoded ahead\n", time[1], decodedAhead);
+	debugPrintf("Checksum %08x, %u frames differ\n", total, mismatches);
+	return true;
+}
+#endif
+
+#ifdef ENABLE_HE
+bool ScummDebugger::Cmd_AIStats(int argc, const char **argv) {
+	AI *ai = ((ScummEngine_v100he *)_vm)->_moonbase->_ai;
+
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		ai->resetStats();
+	} else if (argc == 3 && !strcmp(argv[1], "cache") && (!strcmp(argv[2], "on") || !strcmp(argv[2], "off"))) {
+		ai->setUseQueryCache(!strcmp(argv[2], "on"));
+	} else if (argc != 1) {
+		debugPrintf("Shows the time the AI spent on its turns since the last reset\n");
+		debugPrintf("Usage: %s [reset | cache on|off]\n", argv[0]);
+		return true;
+	}
+
+	// The AI queries the game scripts while it searches, so its turns can only
+	// be timed in the running game: load a savegame, reset, and let it play
+	const AI::Stats &stats = ai->getStats();
+	debugPrintf("%u turns, %u calls: %u ms", stats.turns, stats.calls, stats.time);
+	if (stats.turns)
+		debugPrintf(", %u ms per turn", stats.time / stats.turns);
+	debugPrintf("\n");
+	debugPrintf("Query cache %s: %u hits, %u misses\n", ai->getUseQueryCache() ? "on" : "off", stats.cacheHits, stats.cacheMisses);
+	return true;
+}
+#endif
+
 } // End of namespace Scumm
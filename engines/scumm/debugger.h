@@ -69,6 +69,16 @@ private:
 
 	bool Cmd_ResetCursors(int argc, const char **argv);
 
+	bool Cmd_StripBench(int argc, const char **argv);
+
+#ifdef ENABLE_SCUMM_7_8
+	bool Cmd_SanBench(int argc, const char **argv);
+#endif
+
+#ifdef ENABLE_HE
+	bool Cmd_AIStats(int argc, const char **argv);
+#endif
+
 	void printBox(int box);
 	void drawBox(int box);
 };
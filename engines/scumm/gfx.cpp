@@ -213,6 +213,7 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_decomp_mask = 0;
 	_vertStripNextInc = 0;
 	_zbufferDisabled = false;
+	_inlinePalette = true;
 	_objectMode = false;
 	_distaff = false;
 }
@@ -1876,6 +1877,22 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 
 bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr) {
+	const byte *src = getStripPtr(smap_ptr, stripnr);
+
+	// Indy4 Amiga always uses the room or verb palette map to match colors to
+	// the currently setup palette, thus we need to select it over here too.
+	// Done like the original interpreter.
+	if (_vm->_game.platform == Common::kPlatformAmiga && _vm->_game.id == GID_INDY4) {
+		if (vs->number == kVerbVirtScreen)
+			_roomPalette = _vm->_verbPalette;
+		else
+			_roomPalette = _vm->_roomPalette;
+	}
+
+	return decompressBitmap(dstPtr, vs->pitch, src, height);
+}
+
+const byte *Gdi::getStripPtr(const byte *smap_ptr, int stripnr) const {
 	// Do some input verification and make sure the strip/strip offset
 	// are actually valid. Normally, this should never be a problem,
 	// but if e.g. a savegame gets corrupted, we can easily get into
@@ -1903,17 +1920,37 @@ bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width,
 	}
 	assertRange(0, offset, smapLen-1, "screen strip");
 
-	// Indy4 Amiga always uses the room or verb palette map to match colors to
-	// the currently setup palette, thus we need to select it over here too.
-	// Done like the original interpreter.
-	if (_vm->_game.platform == Common::kPlatformAmiga && _vm->_game.id == GID_INDY4) {
-		if (vs->number == kVerbVirtScreen)
-			_roomPalette = _vm->_verbPalette;
-		else
-			_roomPalette = _vm->_roomPalette;
-	}
+	return smap_ptr + offset;
+}
+
+bool Gdi::checksumStrips(const byte *ptr, byte *dst, int dstPitch, int numstrip, int height, bool inlinePalette, uint32 &checksum) {
+	const byte *smap_ptr;
 
-	return decompressBitmap(dstPtr, vs->pitch, smap_ptr + offset, height);
+	if ((_vm->_game.features & GF_SMALL_HEADER) || _vm->_game.version == 8)
+		smap_ptr = ptr;
+	else
+		smap_ptr = _vm->findResource(MKTAG('S','M','A','P'), ptr);
+
+	// HE rooms drawn with drawBMAPBg() have no SMAP
+	if (!smap_ptr)
+		return false;
+
+	const bool oldInlinePalette = _inlinePalette;
+	_inlinePalette = inlinePalette;
+	_vertStripNextInc = height * dstPitch - 1 * _vm->_bytesPerPixel;
+
+	memset(dst, 0, dstPitch * height);
+	for (int stripnr = 0; stripnr < numstrip; ++stripnr)
+		decompressBitmap(dst + stripnr * 8 * _vm->_bytesPerPixel, dstPitch, getStripPtr(smap_ptr, stripnr), height);
+
+	_inlinePalette = oldInlinePalette;
+
+	// FNV-1a
+	checksum = 2166136261U;
+	for (int i = 0; i < dstPitch * height; ++i)
+		checksum = (checksum ^ dst[i]) * 16777619U;
+
+	return true;
 }
 
 bool GdiNES::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
@@ -3334,12 +3371,30 @@ void Gdi::drawStripEGA(byte *dst, int dstPitch, const byte *src, int height) con
 		}                            \
 	} while (0)
 
-// NOTE: drawStripHE is actually very similar to drawStripComplex
+template<bool paletted>
+inline void Gdi::writeStripColor(byte *dst, byte color, const byte *palette) const {
+	if (paletted)
+		*dst = palette[(color + _paletteMod) & 0xFF];
+	else
+		writeRoomColor(dst, color);
+}
+
 void Gdi::drawStripHE(byte *dst, int dstPitch, const byte *src, int width, int height, const bool transpCheck) const {
+	if (_vm->_bytesPerPixel == 1 && _inlinePalette)
+		drawStripHEImpl<true>(dst, dstPitch, src, width, height, transpCheck);
+	else
+		drawStripHEImpl<false>(dst, dstPitch, src, width, height, transpCheck);
+}
+
+// NOTE: drawStripHE is actually very similar to drawStripComplex
+template<bool paletted>
+void Gdi::drawStripHEImpl(byte *dst, int dstPitch, const byte *src, int width, int height, const bool transpCheck) const {
 	static const int delta_color[] = { -4, -3, -2, -1, 1, 2, 3, 4 };
 	uint32 dataBit, data;
 	byte color;
 	int shift;
+	const byte *palette = _roomPalette;
+	const int bytesPerPixel = paletted ? 1 : _vm->_bytesPerPixel;
 
 	color = *src++;
 	data = READ_LE_UINT24(src);
@@ -3349,12 +3404,12 @@ void Gdi::drawStripHE(byte *dst, int dstPitch, const byte *src, int width, int h
 	int x = width;
 	while (1) {
 		if (!transpCheck || color != _transparentColor)
-			writeRoomColor(dst, color);
-		dst += _vm->_bytesPerPixel;
+			writeStripColor<paletted>(dst, color, palette);
+		dst += bytesPerPixel;
 		--x;
 		if (x == 0) {
 			x = width;
-			dst += dstPitch - width * _vm->_bytesPerPixel;
+			dst += dstPitch - width * bytesPerPixel;
 			--height;
 			if (height == 0)
 				return;
@@ -3427,19 +3482,29 @@ void Gdi::drawStrip3DO(byte *dst, int dstPitch, const byte *src, int height, con
 	} while (0)
 
 void Gdi::drawStripComplex(byte *dst, int dstPitch, const byte *src, int height, const bool transpCheck) const {
+	if (_vm->_bytesPerPixel == 1 && _inlinePalette)
+		drawStripComplexImpl<true>(dst, dstPitch, src, height, transpCheck);
+	else
+		drawStripComplexImpl<false>(dst, dstPitch, src, height, transpCheck);
+}
+
+template<bool paletted>
+void Gdi::drawStripComplexImpl(byte *dst, int dstPitch, const byte *src, int height, const bool transpCheck) const {
 	byte color = *src++;
 	uint bits = *src++;
 	byte cl = 8;
 	byte bit;
 	byte incm, reps;
+	const byte *palette = _roomPalette;
+	const int bytesPerPixel = paletted ? 1 : _vm->_bytesPerPixel;
 
 	do {
 		int x = 8;
 		do {
 			FILL_BITS;
 			if (!transpCheck || color != _transparentColor)
-				writeRoomColor(dst, color);
-			dst += _vm->_bytesPerPixel;
+				writeStripColor<paletted>(dst, color, palette);
+			dst += bytesPerPixel;
 
 		againPos:
 			if (!READ_BIT) {
@@ -3460,13 +3525,13 @@ void Gdi::drawStripComplex(byte *dst, int dstPitch, const byte *src, int height,
 					do {
 						if (!--x) {
 							x = 8;
-							dst += dstPitch - 8 * _vm->_bytesPerPixel;
+							dst += dstPitch - 8 * bytesPerPixel;
 							if (!--height)
 								return;
 						}
 						if (!transpCheck || color != _transparentColor)
-							writeRoomColor(dst, color);
-						dst += _vm->_bytesPerPixel;
+							writeStripColor<paletted>(dst, color, palette);
+						dst += bytesPerPixel;
 					} while (--reps);
 					bits >>= 8;
 					bits |= (*src++) << (cl - 8);
@@ -3474,24 +3539,34 @@ void Gdi::drawStripComplex(byte *dst, int dstPitch, const byte *src, int height,
 				}
 			}
 		} while (--x);
-		dst += dstPitch - 8 * _vm->_bytesPerPixel;
+		dst += dstPitch - 8 * bytesPerPixel;
 	} while (--height);
 }
 
 void Gdi::drawStripBasicH(byte *dst, int dstPitch, const byte *src, int height, const bool transpCheck) const {
+	if (_vm->_bytesPerPixel == 1 && _inlinePalette)
+		drawStripBasicHImpl<true>(dst, dstPitch, src, height, transpCheck);
+	else
+		drawStripBasicHImpl<false>(dst, dstPitch, src, height, transpCheck);
+}
+
+template<bool paletted>
+void Gdi::drawStripBasicHImpl(byte *dst, int dstPitch, const byte *src, int height, const bool transpCheck) const {
 	byte color = *src++;
 	uint bits = *src++;
 	byte cl = 8;
 	byte bit;
 	int8 inc = -1;
+	const byte *palette = _roomPalette;
+	const int bytesPerPixel = paletted ? 1 : _vm->_bytesPerPixel;
 
 	do {
 		int x = 8;
 		do {
 			FILL_BITS;
 			if (!transpCheck || color != _transparentColor)
-				writeRoomColor(dst, color);
-			dst += _vm->_bytesPerPixel;
+				writeStripColor<paletted>(dst, color, palette);
+			dst += bytesPerPixel;
 			if (!READ_BIT) {
 			} else if (!READ_BIT) {
 				FILL_BITS;
@@ -3506,16 +3581,25 @@ void Gdi::drawStripBasicH(byte *dst, int dstPitch, const byte *src, int height,
 				color += inc;
 			}
 		} while (--x);
-		dst += dstPitch - 8 * _vm->_bytesPerPixel;
+		dst += dstPitch - 8 * bytesPerPixel;
 	} while (--height);
 }
 
 void Gdi::drawStripBasicV(byte *dst, int dstPitch, const byte *src, int height, const bool transpCheck) const {
+	if (_vm->_bytesPerPixel == 1 && _inlinePalette)
+		drawStripBasicVImpl<true>(dst, dstPitch, src, height, transpCheck);
+	else
+		drawStripBasicVImpl<false>(dst, dstPitch, src, height, transpCheck);
+}
+
+template<bool paletted>
+void Gdi::drawStripBasicVImpl(byte *dst, int dstPitch, const byte *src, int height, const bool transpCheck) const {
 	byte color = *src++;
 	uint bits = *src++;
 	byte cl = 8;
 	byte bit;
 	int8 inc = -1;
+	const byte *palette = _roomPalette;
 
 	int x = 8;
 	do {
@@ -3523,7 +3607,7 @@ void Gdi::drawStripBasicV(byte *dst, int dstPitch, const byte *src, int height,
 		do {
 			FILL_BITS;
 			if (!transpCheck || color != _transparentColor)
-				writeRoomColor(dst, color);
+				writeStripColor<paletted>(dst, color, palette);
 			dst += dstPitch;
 			if (!READ_BIT) {
 			} else if (!READ_BIT) {
@@ -206,6 +206,9 @@ protected:
 
 	bool _zbufferDisabled;
 
+	/** Flag which is false to force the generic strip decoders on 8-bit screens. */
+	bool _inlinePalette;
+
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
@@ -237,12 +240,30 @@ protected:
 	void drawStripHE(byte *dst, int dstPitch, const byte *src, int width, int height, const bool transpCheck) const;
 	virtual void writeRoomColor(byte *dst, byte color) const;
 
+	/**
+	 * The bit stream strip decoders are instantiated twice: for 8-bit screens
+	 * the room palette is looked up inline, otherwise every pixel is written
+	 * through the virtual writeRoomColor(). The wrappers above pick one at
+	 * runtime.
+	 */
+	template<bool paletted>
+	void writeStripColor(byte *dst, byte color, const byte *palette) const;
+	template<bool paletted>
+	void drawStripComplexImpl(byte *dst, int dstPitch, const byte *src, int height, const bool transpCheck) const;
+	template<bool paletted>
+	void drawStripBasicHImpl(byte *dst, int dstPitch, const byte *src, int height, const bool transpCheck) const;
+	template<bool paletted>
+	void drawStripBasicVImpl(byte *dst, int dstPitch, const byte *src, int height, const bool transpCheck) const;
+	template<bool paletted>
+	void drawStripHEImpl(byte *dst, int dstPitch, const byte *src, int width, int height, const bool transpCheck) const;
+
 	/* Mask decompressors */
 	void decompressMaskImgOr(byte *dst, const byte *src, int height) const;
 	void decompressMaskImg(byte *dst, const byte *src, int height) const;
 
 	/* Misc */
 	int getZPlanes(const byte *smap_ptr, const byte *zplane_list[9], bool bmapImage) const;
+	const byte *getStripPtr(const byte *smap_ptr, int stripnr) const;
 
 	virtual bool drawStrip(byte *dstPtr, VirtScreen *vs,
 					int x, int y, const int width, const int height,
@@ -268,6 +289,14 @@ public:
 	void drawBitmap(const byte *ptr, VirtScreen *vs, int x, int y, const int width, const int height,
 	                int stripnr, int numstrip, byte flag);
 
+	/**
+	 * Decode every strip of a room image into dst and checksum the result,
+	 * either with the specialised 8-bit decoders or with the generic ones.
+	 * Used by the strip_bench debugger command. Returns false if the image
+	 * has no strips.
+	 */
+	bool checksumStrips(const byte *ptr, byte *dst, int dstPitch, int numstrip, int height, bool inlinePalette, uint32 &checksum);
+
 #ifdef ENABLE_HE
 	void drawBMAPBg(const byte *ptr, VirtScreen *vs);
 	void drawBMAPObject(const byte *ptr, VirtScreen *vs, int obj, int x, int y, int w, int h);
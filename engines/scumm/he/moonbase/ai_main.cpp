@@ -20,6 +20,8 @@
  *
  */
 
+#include "common/system.h"
+
 #include "scumm/he/intern_he.h"
 
 #include "scumm/he/moonbase/moonbase.h"
@@ -160,6 +162,16 @@ AI::AI(ScummEngine_v100he *vm) : _vm(vm) {
 
 	memset(_moveList, 0, sizeof(_moveList));
 	_mcpParams = 0;
+
+	_queryCacheHits = 0;
+	_queryCacheMisses = 0;
+	_useQueryCache = true;
+	resetQueryCache();
+	resetStats();
+}
+
+void AI::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
 }
 
 void AI::resetAI() {
@@ -183,6 +195,18 @@ void AI::resetAI() {
 
 		_moveList[i] = new patternList;
 	}
+
+	resetQueryCache();
+}
+
+void AI::resetQueryCache() {
+	if (_queryCacheHits || _queryCacheMisses)
+		debugC(DEBUG_MOONBASE_AI, "Query cache: %u hits, %u misses", _queryCacheHits, _queryCacheMisses);
+
+	memset(_distanceCache, 0, sizeof(_distanceCache));
+	memset(_terrainCache, 0, sizeof(_terrainCache));
+	_queryCacheHits = 0;
+	_queryCacheMisses = 0;
 }
 
 void AI::cleanUpAI() {
@@ -221,6 +245,17 @@ void AI::setAIType(const int paramCount, const int32 *params) {
 }
 
 int AI::masterControlProgram(const int paramCount, const int32 *params) {
+	// The AI runs a bit of its search on every call, so sum up the time of
+	// the calls. The millisecond rounding of each call evens out over a turn.
+	uint32 startTime = g_system->getMillis();
+	int retVal = runMasterControlProgram(paramCount, params);
+
+	_stats.time += g_system->getMillis() - startTime;
+	_stats.calls++;
+	return retVal;
+}
+
+int AI::runMasterControlProgram(const int paramCount, const int32 *params) {
 	static Tree *myTree;
 
 	static int index;
@@ -315,6 +350,10 @@ int AI::masterControlProgram(const int paramCount, const int32 *params) {
 
 	switch (_aiState) {
 	case STATE_CHOOSE_BEHAVIOR:
+		// A new turn starts, so buildings and terrain may have changed
+		resetQueryCache();
+		_stats.turns++;
+
 		_behavior = chooseBehavior();
 		debugC(DEBUG_MOONBASE_AI, "Behavior mode: %d", _behavior);
 
@@ -2415,7 +2454,26 @@ int AI::getClosestUnit(int x, int y, int radius, int player, int alignment, int
 }
 
 int AI::getDistance(int originX, int originY, int endX, int endY) {
+	uint hash = (uint)originX * 73856093U ^ (uint)originY * 19349663U ^ (uint)endX * 83492791U ^ (uint)endY * 2654435761U;
+	DistanceCacheEntry &entry = _distanceCache[(hash ^ (hash >> 16)) % kQueryCacheSize];
+
+	if (_useQueryCache && entry.valid && entry.originX == originX && entry.originY == originY && entry.endX == endX && entry.endY == endY) {
+		_queryCacheHits++;
+		_stats.cacheHits++;
+		return entry.distance;
+	}
+
 	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_WORLD_DIST], 4, originX, originY, endX, endY);
+
+	_queryCacheMisses++;
+	_stats.cacheMisses++;
+	entry.originX = originX;
+	entry.originY = originY;
+	entry.endX = endX;
+	entry.endY = endY;
+	entry.distance = retVal;
+	entry.valid = true;
+
 	return retVal;
 }
 
@@ -2430,7 +2488,24 @@ int AI::calcAngle(int originX, int originY, int endX, int endY, int noWrapFlag)
 }
 
 int AI::getTerrain(int x, int y) {
+	uint hash = (uint)x * 73856093U ^ (uint)y * 19349663U;
+	TerrainCacheEntry &entry = _terrainCache[(hash ^ (hash >> 16)) % kQueryCacheSize];
+
+	if (_useQueryCache && entry.valid && entry.x == x && entry.y == y) {
+		_queryCacheHits++;
+		_stats.cacheHits++;
+		return entry.terrain;
+	}
+
 	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_TERRAIN_TYPE], 2, x, y);
+
+	_queryCacheMisses++;
+	_stats.cacheMisses++;
+	entry.x = x;
+	entry.y = y;
+	entry.terrain = retVal;
+	entry.valid = true;
+
 	return retVal;
 }
 
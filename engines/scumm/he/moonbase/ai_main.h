@@ -92,7 +92,27 @@ public:
 	void setAIType(const int paramCount, const int32 *params);
 	int masterControlProgram(const int paramCount, const int32 *params);
 
+	/**
+	 * Time spent in masterControlProgram() and query cache use since the
+	 * last reset, shown by the ai_stats debugger command
+	 */
+	struct Stats {
+		uint32 turns;
+		uint32 calls;
+		uint32 time;
+		uint32 cacheHits;
+		uint32 cacheMisses;
+	};
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
+	bool getUseQueryCache() const { return _useQueryCache; }
+	void setUseQueryCache(bool use) { _useQueryCache = use; }
+
 private:
+	int runMasterControlProgram(const int paramCount, const int32 *params);
+
 	int chooseBehavior();
 	int chooseTarget(int behavior);
 
@@ -189,6 +209,35 @@ private:
 	int energyPoolSize(int pool);
 	int getMaxCollectors(int pool);
 
+	void resetQueryCache();
+
+	// getDistance() and getTerrain() call into the game scripts, which gets
+	// expensive when the search trees query the same locations over and over,
+	// so their results are memoized for the duration of a turn
+	enum {
+		kQueryCacheSize = 4096
+	};
+
+	struct DistanceCacheEntry {
+		int originX, originY, endX, endY;
+		int distance;
+		bool valid;
+	};
+
+	struct TerrainCacheEntry {
+		int x, y;
+		int terrain;
+		bool valid;
+	};
+
+	DistanceCacheEntry _distanceCache[kQueryCacheSize];
+	TerrainCacheEntry _terrainCache[kQueryCacheSize];
+	uint32 _queryCacheHits;
+	uint32 _queryCacheMisses;
+	bool _useQueryCache;
+
+	Stats _stats;
+
 public:
 	Common::Array<int> _lastXCoord[5];
 	Common::Array<int> _lastYCoord[5];
@@ -35,9 +35,36 @@ class AI;
 
 struct TreeNode {
 	float value;
+	uint32 order;
 	Node *node;
 
-	TreeNode(float v, Node *n) { value = v; node = n; }
+	TreeNode() { value = 0; order = 0; node = NULL; }
+	TreeNode(float v, uint32 o, Node *n) { value = v; order = o; node = n; }
+};
+
+/**
+ * Open set of the A* search, kept as a binary min-heap ordered by T value.
+ * Nodes with equal values are returned in insertion order. The storage is
+ * kept when the set is cleared, so it can be reused by following searches.
+ */
+class OpenSet {
+private:
+	Common::Array<TreeNode> _heap;
+	uint32 _order;
+
+	bool less(const TreeNode &a, const TreeNode &b) const {
+		return a.value < b.value || (a.value == b.value && a.order < b.order);
+	}
+
+public:
+	OpenSet() : _order(0) {}
+
+	void clear() { _heap.resize(0); _order = 0; }
+	bool empty() const { return _heap.empty(); }
+	uint size() const { return _heap.size(); }
+
+	void push(float value, Node *node);
+	Node *pop();
 };
 
 class Tree {
@@ -49,7 +76,7 @@ private:
 
 	int _currentChildIndex;
 
-	Common::SortedArray<TreeNode *> *_currentMap;
+	OpenSet _openSet;
 	Node *_currentNode;
 
 	AI *_ai;
@@ -45,6 +45,25 @@ namespace Scumm {
 		(dst)[1] = (src)[1];	\
 	} while (0)
 
+#define COPY_8X1_LINE(dst, src)			\
+	do {					\
+		COPY_4X1_LINE(dst, src);	\
+		COPY_4X1_LINE((dst) + 4, (src) + 4);	\
+	} while (0)
+
+#define FILL_4X1_LINE(dst, val)			\
+	do {					\
+		(dst)[0] = val;	\
+		(dst)[1] = val;	\
+		(dst)[2] = val;	\
+		(dst)[3] = val;	\
+	} while (0)
+
+#define FILL_8X1_LINE(dst, val)			\
+	do {					\
+		FILL_4X1_LINE(dst, val);	\
+		FILL_4X1_LINE((dst) + 4, val);	\
+	} while (0)
 
 #else /* SCUMM_NEED_ALIGNMENT */
 
@@ -54,15 +73,17 @@ namespace Scumm {
 #define COPY_2X1_LINE(dst, src)			\
 	*(uint16 *)(dst) = *(const uint16 *)(src)
 
-#endif
+// Whole 8 pixel rows of a level 1 block are moved with one 64-bit access
+#define COPY_8X1_LINE(dst, src)			\
+	*(uint64 *)(dst) = *(const uint64 *)(src)
 
 #define FILL_4X1_LINE(dst, val)			\
-	do {					\
-		(dst)[0] = val;	\
-		(dst)[1] = val;	\
-		(dst)[2] = val;	\
-		(dst)[3] = val;	\
-	} while (0)
+	*(uint32 *)(dst) = (val) * 0x01010101U
+
+#define FILL_8X1_LINE(dst, val)			\
+	*(uint64 *)(dst) = (val) * (uint64)0x0101010101010101ULL
+
+#endif
 
 #define FILL_2X1_LINE(dst, val)			\
 	do {					\
@@ -451,8 +472,7 @@ void Codec47Decoder::level1(byte *d_dst) {
 	if (code < 0xF8) {
 		tmp2 = _table[code] + _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFF) {
@@ -466,8 +486,7 @@ void Codec47Decoder::level1(byte *d_dst) {
 	} else if (code == 0xFE) {
 		byte t = *_d_src++;
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFD) {
@@ -490,15 +509,13 @@ void Codec47Decoder::level1(byte *d_dst) {
 	} else if (code == 0xFC) {
 		tmp2 = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else {
 		byte t = _paramPtr[code];
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	}
@@ -535,11 +552,14 @@ Codec47Decoder::Codec47Decoder(int width, int height) {
 	}
 
 	_frameSize = _width * _height;
-	_deltaSize = _frameSize * 3;
+	_deltaSize = _frameSize * 4;
 	_deltaBuf = (byte *)malloc(_deltaSize);
 	_deltaBufs[0] = _deltaBuf;
 	_deltaBufs[1] = _deltaBuf + _frameSize;
 	_curBuf = _deltaBuf + _frameSize * 2;
+	_aheadBuf = _deltaBuf + _frameSize * 3;
+	_aheadSrc = NULL;
+	_prevSeqNb = -1;
 }
 
 Codec47Decoder::~Codec47Decoder() {
@@ -558,13 +578,44 @@ Codec47Decoder::~Codec47Decoder() {
 		_deltaBuf = NULL;
 		_deltaBufs[0] = NULL;
 		_deltaBufs[1] = NULL;
+		_aheadBuf = NULL;
 	}
 }
 
+bool Codec47Decoder::decodeAhead(const byte *src, int width, int height) {
+	_aheadSrc = NULL;
+	if ((_tableBig == NULL) || (_tableSmall == NULL) || (_deltaBuf == NULL))
+		return false;
+	if (width != _width || height != _height || _lastTableWidth != _width)
+		return false;
+
+	// Only a delta frame directly following the current one can be decoded
+	// without touching the decoder state. Its result is kept in a spare
+	// buffer until decode() is called with the very same data.
+	int32 seq_nb = READ_LE_UINT16(src + 0);
+	if (src[2] != 2 || seq_nb == 0 || seq_nb != _prevSeqNb + 1)
+		return false;
+
+	const byte *gfx_data = src + 26;
+	if ((src[4] & 1) != 0) {
+		gfx_data += 32896;
+	}
+
+	_offset1 = _deltaBufs[1] - _aheadBuf;
+	_offset2 = _deltaBufs[0] - _aheadBuf;
+	decode2(_aheadBuf, gfx_data, _width, _height, src + 8);
+	_aheadSrc = src;
+
+	return true;
+}
+
 bool Codec47Decoder::decode(byte *dst, const byte *src) {
 	if ((_tableBig == NULL) || (_tableSmall == NULL) || (_deltaBuf == NULL))
 		return false;
 
+	const bool decodedAhead = (src == _aheadSrc);
+	_aheadSrc = NULL;
+
 	_offset1 = _deltaBufs[1] - _curBuf;
 	_offset2 = _deltaBufs[0] - _curBuf;
 
@@ -593,7 +644,10 @@ bool Codec47Decoder::decode(byte *dst, const byte *src) {
 		break;
 	case 2:
 		if (seq_nb == _prevSeqNb + 1) {
-			decode2(_curBuf, gfx_data, _width, _height, src + 8);
+			if (decodedAhead)
+				SWAP(_curBuf, _aheadBuf);
+			else
+				decode2(_curBuf, gfx_data, _width, _height, src + 8);
 		}
 		break;
 	case 3:
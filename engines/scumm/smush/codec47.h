@@ -34,6 +34,8 @@ private:
 	byte *_deltaBufs[2];
 	byte *_deltaBuf;
 	byte *_curBuf;
+	byte *_aheadBuf;
+	const byte *_aheadSrc;
 	int32 _prevSeqNb;
 	int _lastTableWidth;
 	const byte *_d_src, *_paramPtr;
@@ -56,6 +58,14 @@ public:
 	Codec47Decoder(int width, int height);
 	~Codec47Decoder();
 	bool decode(byte *dst, const byte *src);
+
+	/**
+	 * Decode the frame following the current one into a spare buffer,
+	 * so that a later decode() of the same data only has to swap buffers.
+	 * The source data must stay untouched until then.
+	 */
+	bool decodeAhead(const byte *src, int width, int height);
+	void discardAhead() { _aheadSrc = NULL; }
 };
 
 } // End of namespace Scumm
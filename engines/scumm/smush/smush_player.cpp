@@ -22,6 +22,7 @@
 
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/memstream.h"
 #include "common/system.h"
 #include "common/util.h"
 
@@ -230,6 +231,10 @@ SmushPlayer::SmushPlayer(ScummEngine_v7 *scumm) {
 	_base = NULL;
 	_frameBuffer = NULL;
 	_specialBuffer = NULL;
+	_aheadFrame = NULL;
+	_aheadFrameAlloc = 0;
+	_aheadFrameSize = -1;
+	_aheadFobj = NULL;
 
 	_seekPos = -1;
 
@@ -310,6 +315,12 @@ void SmushPlayer::release() {
 	free(_frameBuffer);
 	_frameBuffer = NULL;
 
+	free(_aheadFrame);
+	_aheadFrame = NULL;
+	_aheadFrameAlloc = 0;
+	_aheadFrameSize = -1;
+	_aheadFobj = NULL;
+
 	_IACTstream = NULL;
 
 	_vm->_smushActive = false;
@@ -834,6 +845,13 @@ void SmushPlayer::handleFrameObject(int32 subSize, Common::SeekableReadStream &b
 	b.readUint16LE();
 	b.readUint16LE();
 
+	if (_aheadFobj != NULL && _aheadFobj == _aheadFrame + b.pos()) {
+		// Hand the codec the read-ahead data itself, so that it can pick
+		// up the frame it already decoded from it
+		decodeFrameObject(codec, _aheadFobj, left, top, width, height);
+		return;
+	}
+
 	int32 chunk_size = subSize - 14;
 	byte *chunk_buffer = (byte *)malloc(chunk_size);
 	assert(chunk_buffer);
@@ -980,9 +998,76 @@ SmushFont *SmushPlayer::getFont(int font) {
 	return _sf[font];
 }
 
+void SmushPlayer::readAhead() {
+	if (_aheadFrameSize >= 0 || _seekPos >= 0 || _endOfFile || _insanity || !_base)
+		return;
+
+	// Insane seeks and renders overlays while playing, so only plain
+	// cutscenes are read ahead
+	const int32 chunkPos = _base->pos();
+	if (chunkPos + 8 >= (int32)_baseSize)
+		return;
+
+	const uint32 subType = _base->readUint32BE();
+	const int32 subSize = _base->readUint32BE();
+	if (subType != MKTAG('F','R','M','E') || subSize < 0 || _base->pos() + subSize > (int32)_baseSize) {
+		_base->seek(chunkPos, SEEK_SET);
+		return;
+	}
+
+	if (subSize > _aheadFrameAlloc) {
+		free(_aheadFrame);
+		_aheadFrame = (byte *)malloc(subSize);
+		assert(_aheadFrame);
+		_aheadFrameAlloc = subSize;
+	}
+	if (_base->read(_aheadFrame, subSize) != (uint32)subSize) {
+		_base->seek(chunkPos, SEEK_SET);
+		return;
+	}
+	_aheadFrameSize = subSize;
+	_aheadFobj = NULL;
+
+	if (!_codec47)
+		return;
+	_codec47->discardAhead();
+
+	// Decode the first frame object now if it is a full screen codec 47
+	// delta frame, which is by far the most expensive part of a frame
+	int32 pos = 0;
+	while (pos + 8 <= subSize) {
+		const uint32 type = READ_BE_UINT32(_aheadFrame + pos);
+		const int32 size = READ_BE_UINT32(_aheadFrame + pos + 4);
+		if (size < 0 || pos + 8 + size > subSize)
+			break;
+
+		if (type == MKTAG('F','O','B','J')) {
+			const byte *fobj = _aheadFrame + pos + 8;
+			if (size > 14 && READ_LE_UINT16(fobj) == 47 &&
+				READ_LE_UINT16(fobj + 6) == _vm->_screenWidth && READ_LE_UINT16(fobj + 8) == _vm->_screenHeight) {
+				if (_codec47->decodeAhead(fobj + 14, _vm->_screenWidth, _vm->_screenHeight))
+					_aheadFobj = fobj + 14;
+			}
+			break;
+		}
+
+		pos += 8 + size + (size & 1);
+	}
+}
+
+void SmushPlayer::discardReadAhead() {
+	// Only called before seeking, which repositions the file anyway
+	_aheadFrameSize = -1;
+	_aheadFobj = NULL;
+	if (_codec47)
+		_codec47->discardAhead();
+}
+
 void SmushPlayer::parseNextFrame() {
 
 	if (_seekPos >= 0) {
+		discardReadAhead();
+
 		if (_smixer)
 			_smixer->stop();
 
@@ -1028,6 +1113,16 @@ void SmushPlayer::parseNextFrame() {
 
 	assert(_base);
 
+	if (_aheadFrameSize >= 0) {
+		Common::MemoryReadStream frame(_aheadFrame, _aheadFrameSize);
+		handleFrame(_aheadFrameSize, frame);
+		_aheadFrameSize = -1;
+		_aheadFobj = NULL;
+
+		_vm->_imuseDigital->flushTracks();
+		return;
+	}
+
 	const uint32 subType = _base->readUint32BE();
 	const int32 subSize = _base->readUint32BE();
 	const int32 subOffset = _base->pos();
@@ -1263,6 +1358,7 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 			_IACTpos = 0;
 			break;
 		}
+		readAhead();
 		_vm->_system->delayMillis(10);
 	}
 
@@ -56,6 +56,13 @@ private:
 	byte *_frameBuffer;
 	byte *_specialBuffer;
 
+	// The next FRME chunk, read (and its codec 47 frame object decoded)
+	// during the idle time before it is due
+	byte *_aheadFrame;
+	int32 _aheadFrameAlloc;
+	int32 _aheadFrameSize;
+	const byte *_aheadFobj;
+
 	Common::String _seekFile;
 	uint32 _startFrame;
 	uint32 _startTime;
@@ -115,6 +122,8 @@ protected:
 private:
 	SmushFont *getFont(int font);
 	void parseNextFrame();
+	void readAhead();
+	void discardReadAhead();
 	void init(int32 spped);
 	void setupAnim(const char *file);
 	void updateScreen();
@@ -22,14 +22,164 @@
 
 #include "sword25/console.h"
 #include "sword25/sword25.h"
+#include "sword25/kernel/kernel.h"
+#include "sword25/kernel/resource.h"
+#include "sword25/package/packagemanager.h"
+#include "sword25/gfx/graphicengine.h"
+#include "sword25/gfx/renderobjectmanager.h"
+#include "sword25/gfx/image/vectorimage.h"
+
+#include "common/system.h"
 
 namespace Sword25 {
 
 Sword25Console::Sword25Console(Sword25Engine *vm) : GUI::Debugger(), _vm(vm) {
 	assert(_vm);
+
+	registerCmd("vector_bench", WRAP_METHOD(Sword25Console, Cmd_VectorBench));
+	registerCmd("resource_stats", WRAP_METHOD(Sword25Console, Cmd_ResourceStats));
+	registerCmd("render_stats", WRAP_METHOD(Sword25Console, Cmd_RenderStats));
 }
 
 Sword25Console::~Sword25Console() {
 }
 
+bool Sword25Console::Cmd_ResourceStats(int argc, const char **argv) {
+	static const char *const typeNames[] = { "unknown", "bitmap", "animation", "sound", "font" };
+	const uint typeCount = ARRAYSIZE(typeNames);
+
+	uint count[typeCount] = { 0 };
+	uint locked[typeCount] = { 0 };
+	uint32 memory[typeCount] = { 0 };
+
+	ResourceManager *resourceManager = Kernel::getInstance()->getResourceManager();
+	const Common::List<Resource *> &resources = resourceManager->getResources();
+
+	for (Common::List<Resource *>::const_iterator it = resources.begin(); it != resources.end(); ++it) {
+		uint type = (*it)->getType() < typeCount ? (*it)->getType() : 0;
+		count[type]++;
+		if ((*it)->getLockCount() > 0)
+			locked[type]++;
+		memory[type] += (*it)->getMemoryUsage();
+	}
+
+	debugPrintf("%-10s %6s %6s %10s\n", "type", "count", "locked", "KB");
+	for (uint type = 0; type < typeCount; type++) {
+		if (count[type])
+			debugPrintf("%-10s %6u %6u %10u\n", typeNames[type], count[type], locked[type], memory[type] / 1024);
+	}
+	debugPrintf("Using %u of %u KB\n", resourceManager->getUsedMemory() / 1024, resourceManager->getMaxMemoryUsage() / 1024);
+	debugPrintf("%u hits, %u misses, %u evictions\n", resourceManager->getCacheHits(), resourceManager->getCacheMisses(), resourceManager->getEvictions());
+	debugPrintf("%u files waiting to be precached\n", resourceManager->getPrecacheQueueSize());
+	return true;
+}
+
+bool Sword25Console::Cmd_RenderStats(int argc, const char **argv) {
+	RenderObjectManager *manager = Kernel::getInstance()->getGfx()->getRenderObjectManager();
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "reset")) {
+			manager->resetFrameStats();
+			return true;
+		} else if (!strcmp(argv[1], "full")) {
+			manager->setFullUpdate(!manager->getFullUpdate());
+			manager->resetFrameStats();
+			debugPrintf("Checking %s objects each frame\n", manager->getFullUpdate() ? "all" : "changed");
+			return true;
+		}
+		debugPrintf("Usage: %s [reset|full]\n", argv[0]);
+		return true;
+	}
+
+	const RenderObjectManager::FrameStats &stats = manager->getFrameStats();
+	if (!stats.frames) {
+		debugPrintf("No frames rendered yet\n");
+		return true;
+	}
+
+	debugPrintf("%u frames, checking %s objects\n", stats.frames, manager->getFullUpdate() ? "all" : "changed");
+	debugPrintf("Per frame: %u objects, %u checked, %u update rects\n",
+		stats.objects / stats.frames, stats.checked / stats.frames, stats.updateRects / stats.frames);
+	debugPrintf("Per frame: %.2fms update, %.2fms queue, %.2fms render\n",
+		(double)stats.updateTime / stats.frames, (double)stats.queueTime / stats.frames, (double)stats.renderTime / stats.frames);
+	return true;
+}
+
+bool Sword25Console::Cmd_VectorBench(int argc, const char **argv) {
+	int minScale = 25;
+	int maxScale = 200;
+	int step = 25;
+
+	if (argc > 4 || argc == 2) {
+		debugPrintf("Usage: %s [<min %%> <max %%> [<step %%>]]\n", argv[0]);
+		debugPrintf("Renders every vector image at a sweep of sizes, twice\n");
+		return true;
+	}
+	if (argc >= 3) {
+		minScale = atoi(argv[1]);
+		maxScale = atoi(argv[2]);
+	}
+	if (argc == 4)
+		step = atoi(argv[3]);
+	if (minScale <= 0 || maxScale < minScale || step <= 0) {
+		debugPrintf("Invalid scale range\n");
+		return true;
+	}
+
+	PackageManager *package = Kernel::getInstance()->getPackage();
+
+	// Patterns don't match across directories, so search a few levels deep
+	Common::ArchiveMemberList files;
+	Common::String filter = "/*.swf";
+	for (int depth = 0; depth < 8; depth++) {
+		package->doSearch(files, filter, "", PackageManager::FT_FILE);
+		filter = "/*" + filter;
+	}
+
+	uint images = 0;
+	uint renders = 0;
+	uint32 coldTime = 0;
+	uint32 warmTime = 0;
+
+	for (Common::ArchiveMemberList::iterator it = files.begin(); it != files.end(); ++it) {
+		Common::String fileName = (*it)->getName();
+		if (!fileName.hasPrefix("/"))
+			fileName = "/" + fileName;
+
+		uint fileSize;
+		byte *fileData = package->getFile(fileName, &fileSize);
+		if (!fileData)
+			continue;
+
+		bool success = false;
+		VectorImage image(fileData, fileSize, success, fileName);
+		delete[] fileData;
+		if (!success)
+			continue;
+
+		// The first sweep also pays for the scale independent tessellation
+		for (int pass = 0; pass < 2; pass++) {
+			uint32 start = g_system->getMillis();
+
+			for (int scale = minScale; scale <= maxScale; scale += step) {
+				int width = MAX(image.getWidth() * scale / 100, 1);
+				int height = MAX(image.getHeight() * scale / 100, 1);
+				free(image.render(width, height));
+				if (pass == 0)
+					renders++;
+			}
+
+			if (pass == 0)
+				coldTime += g_system->getMillis() - start;
+			else
+				warmTime += g_system->getMillis() - start;
+		}
+		images++;
+	}
+
+	debugPrintf("%u images, %u sizes each: %u renders\n", images, (maxScale - minScale) / step + 1, renders);
+	debugPrintf("First sweep: %u ms, second sweep: %u ms\n", coldTime, warmTime);
+	return true;
+}
+
 } // End of namespace Sword25
@@ -35,6 +35,10 @@ public:
 	virtual ~Sword25Console(void);
 
 private:
+	bool Cmd_VectorBench(int argc, const char **argv);
+	bool Cmd_ResourceStats(int argc, const char **argv);
+	bool Cmd_RenderStats(int argc, const char **argv);
+
 	Sword25Engine *_vm;
 };
 
@@ -32,7 +32,7 @@
 #include "sword25/gfx/animationresource.h"
 
 #include "sword25/kernel/kernel.h"
-#include "sword25/kernel/resmanager.h" // for PRECACHE_RESOURCES
+#include "sword25/kernel/resmanager.h"
 #include "sword25/package/packagemanager.h"
 #include "sword25/gfx/bitmapresource.h"
 
@@ -203,18 +203,22 @@ bool AnimationResource::parserCallback_frame(ParserNode *node) {
 AnimationResource::~AnimationResource() {
 }
 
+uint AnimationResource::getMemoryUsage() const {
+	// The frame images are resources of their own and are charged for
+	// separately, so this is the frame list and the strings it holds
+	uint size = sizeof(*this) + getFileName().size() + 1 + _frames.size() * sizeof(Frame);
+	Common::Array<Frame>::const_iterator iter = _frames.begin();
+	for (; iter != _frames.end(); ++iter)
+		size += (*iter).fileName.size() + 1 + (*iter).action.size() + 1;
+
+	return size;
+}
+
 bool AnimationResource::precacheAllFrames() const {
 	Common::Array<Frame>::const_iterator iter = _frames.begin();
 	for (; iter != _frames.end(); ++iter) {
-#ifdef PRECACHE_RESOURCES
-		if (!Kernel::getInstance()->getResourceManager()->precacheResource((*iter).fileName)) {
-			error("Could not precache \"%s\".", (*iter).fileName.c_str());
-			return false;
-		}
-#else
 		Resource *pResource = Kernel::getInstance()->getResourceManager()->requestResource((*iter).fileName);
 		pResource->release(); //unlock precached resource
-#endif
 	}
 
 	return true;
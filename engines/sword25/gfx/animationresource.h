@@ -48,6 +48,8 @@ public:
 	AnimationResource(const Common::String &filename);
 	virtual ~AnimationResource();
 
+	virtual uint getMemoryUsage() const;
+
 	virtual const Frame &getFrame(uint index) const {
 		return _frames[index];
 	}
@@ -61,6 +61,11 @@ public:
 		return _valid;
 	}
 
+	virtual uint getMemoryUsage() const {
+		// The character map image is a resource of its own
+		return sizeof(*this) + getFileName().size() + 1 + _bitmapFileName.size() + 1;
+	}
+
 	/**
 	    @brief Gibt die Zeilenhhe des Fonts in Pixeln zurck.
 
@@ -61,6 +61,7 @@ enum {
 namespace Sword25 {
 
 static const uint FRAMETIME_SAMPLE_COUNT = 5;       // Frame duration is averaged over FRAMETIME_SAMPLE_COUNT frames
+static const uint PRECACHE_TIME_SLICE = 4;          // Milliseconds per frame spent loading precached resources
 
 GraphicEngine::GraphicEngine(Kernel *pKernel) :
 	_width(0),
@@ -146,6 +147,9 @@ bool GraphicEngine::endFrame() {
 
 	g_system->updateScreen();
 
+	// Use some of the frame to load resources the scripts asked to be precached
+	Kernel::getInstance()->getResourceManager()->processPrecacheQueue(PRECACHE_TIME_SLICE);
+
 	return true;
 }
 
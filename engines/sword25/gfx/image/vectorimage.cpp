@@ -43,6 +43,14 @@ namespace Sword25 {
 
 #define BEZSMOOTHNESS 0.5
 
+// Limits of the render cache, see VectorImage::getRender()
+#define MAX_RENDERS_PER_IMAGE 4
+#define RENDER_CACHE_BUDGET (16 * 1024 * 1024)
+
+VectorImage *VectorImage::_firstCached = 0;
+uint32 VectorImage::_renderCacheSize = 0;
+uint32 VectorImage::_renderCacheClock = 0;
+
 // -----------------------------------------------------------------------------
 // SWF datatype
 // -----------------------------------------------------------------------------
@@ -215,7 +223,8 @@ Common::Rect CalculateBoundingBox(const VectorImageElement &vectorImageElement)
 // Construction
 // -----------------------------------------------------------------------------
 
-VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _pixelData(0), _fname(fname) {
+VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname)  :
+	_shapesPrepared(false), _prevCached(0), _nextCached(0), _fname(fname) {
 	success = false;
 	_bgColor = 0;
 
@@ -312,7 +321,26 @@ VectorImage::~VectorImage() {
 			if (_elements[j].getPathInfo(i).getVec())
 				free(_elements[j].getPathInfo(i).getVec());
 
-	free(_pixelData);
+	freeShapes();
+
+	while (!_renderCache.empty())
+		dropRender(_renderCache.size() - 1);
+}
+
+void VectorImage::freeShapes() {
+	for (uint e = 0; e < _elements.size(); e++) {
+		VectorImageElement &element = _elements[e];
+
+		for (uint i = 0; i < element._fillShapes.size(); i++)
+			art_svp_free(element._fillShapes[i]);
+		for (uint i = 0; i < element._strokeShapes.size(); i++)
+			free(element._strokeShapes[i]);
+
+		element._fillShapes.clear();
+		element._strokeShapes.clear();
+	}
+
+	_shapesPrepared = false;
 }
 
 
@@ -616,26 +644,15 @@ bool VectorImage::blit(int posX, int posY,
                        uint color,
                        int width, int height,
 					   RectangleList *updateRects) {
-	static VectorImage *oldThis = 0;
-	static int              oldWidth = -2;
-	static int              oldHeight = -2;
-
 	// If width or height to 0, nothing needs to be shown.
 	if (width == 0 || height == 0)
 		return true;
 
-	// Determine if the old image in the cache can not be reused and must be recalculated
-	if (!(oldThis == this && oldWidth == width && oldHeight == height)) {
-		render(width, height);
-
-		oldThis = this;
-		oldHeight = height;
-		oldWidth = width;
-	}
+	byte *pixelData = getRender(width, height);
 
 	RenderedImage *rend = new RenderedImage();
 
-	rend->replaceContent(_pixelData, width, height);
+	rend->replaceContent(pixelData, width, height);
 	rend->blit(posX, posY, flipping, pPartRect, color, width, height, updateRects);
 
 	delete rend;
@@ -643,4 +660,84 @@ bool VectorImage::blit(int posX, int posY,
 	return true;
 }
 
+byte *VectorImage::getRender(int width, int height) {
+	_renderCacheClock++;
+
+	for (uint i = 0; i < _renderCache.size(); i++) {
+		if (_renderCache[i].width == width && _renderCache[i].height == height) {
+			_renderCache[i].lastUse = _renderCacheClock;
+			return _renderCache[i].pixelData;
+		}
+	}
+
+	debug(3, "VectorImage::getRender(%d, %d) miss, %d bytes cached", width, height, _renderCacheSize);
+
+	if (_renderCache.size() >= MAX_RENDERS_PER_IMAGE) {
+		uint oldest = 0;
+		for (uint i = 1; i < _renderCache.size(); i++) {
+			if (_renderCache[i].lastUse < _renderCache[oldest].lastUse)
+				oldest = i;
+		}
+		dropRender(oldest);
+	}
+
+	const uint32 size = width * height * 4;
+	trimRenderCache(size < RENDER_CACHE_BUDGET ? RENDER_CACHE_BUDGET - size : 0);
+
+	RenderCacheEntry entry;
+	entry.width = width;
+	entry.height = height;
+	entry.pixelData = render(width, height);
+	entry.lastUse = _renderCacheClock;
+
+	if (_renderCache.empty()) {
+		_prevCached = 0;
+		_nextCached = _firstCached;
+		if (_firstCached)
+			_firstCached->_prevCached = this;
+		_firstCached = this;
+	}
+
+	_renderCache.push_back(entry);
+	_renderCacheSize += size;
+
+	return entry.pixelData;
+}
+
+void VectorImage::dropRender(uint index) {
+	RenderCacheEntry &entry = _renderCache[index];
+
+	_renderCacheSize -= entry.width * entry.height * 4;
+	free(entry.pixelData);
+	_renderCache.remove_at(index);
+
+	if (_renderCache.empty()) {
+		if (_prevCached)
+			_prevCached->_nextCached = _nextCached;
+		else
+			_firstCached = _nextCached;
+		if (_nextCached)
+			_nextCached->_prevCached = _prevCached;
+		_prevCached = _nextCached = 0;
+	}
+}
+
+void VectorImage::trimRenderCache(uint32 budget) {
+	while (_renderCacheSize > budget && _firstCached) {
+		VectorImage *oldestImage = 0;
+		uint oldestIndex = 0;
+
+		for (VectorImage *image = _firstCached; image; image = image->_nextCached) {
+			for (uint i = 0; i < image->_renderCache.size(); i++) {
+				if (!oldestImage || image->_renderCache[i].lastUse < oldestImage->_renderCache[oldestIndex].lastUse) {
+					oldestImage = image;
+					oldestIndex = i;
+				}
+			}
+		}
+
+		oldestImage->dropRender(oldestIndex);
+	}
+}
+
 } // End of namespace Sword25
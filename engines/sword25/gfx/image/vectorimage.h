@@ -144,6 +144,12 @@ private:
 	Common::Array<LineStyleType> _lineStyles;
 	Common::Array<uint32>  _fillStyles;
 	Common::Rect _boundingBox;
+
+	// Scale independent tessellations, built on the first render and
+	// relative to the image bounding box: one SVP per fill style and one
+	// flattened path per path with a line style (0 otherwise).
+	Common::Array<ArtSVP *> _fillShapes;
+	Common::Array<ArtVpath *> _strokeShapes;
 };
 
 
@@ -183,7 +189,11 @@ public:
 	}
 	virtual bool fill(const Common::Rect *pFillRect = 0, uint color = BS_RGB(0, 0, 0));
 
-	void render(int width, int height);
+	/**
+	 * Rasterizes the image at the given size into a newly allocated ARGB
+	 * buffer, which the caller has to free().
+	 */
+	byte *render(int width, int height);
 
 	virtual uint getPixel(int x, int y);
 	virtual bool isBlitSource() const {
@@ -222,10 +232,39 @@ private:
 	bool parseStyles(uint shapeType, SWFBitStream &bs, uint &numFillBits, uint &numLineBits);
 
 	ArtBpath *storeBez(ArtBpath *bez, int lineStyle, int fillStyle0, int fillStyle1, int *bezNodes, int *bezAllocated);
+	void prepareShapes();
+	void freeShapes();
+
 	Common::Array<VectorImageElement>    _elements;
 	Common::Rect                         _boundingBox;
+	bool                                 _shapesPrepared;
+
+	/**
+	 * Rendered images are kept for a few sizes per image, so that animation
+	 * frames drawn at an unchanged scale are not rasterized again. All images
+	 * share one byte budget and the least recently used render is dropped
+	 * first.
+	 */
+	struct RenderCacheEntry {
+		int width;
+		int height;
+		byte *pixelData;
+		uint32 lastUse;
+	};
+
+	byte *getRender(int width, int height);
+	void dropRender(uint index);
+	static void trimRenderCache(uint32 budget);
+
+	Common::Array<RenderCacheEntry> _renderCache;
+
+	// Intrusive list of all images with cached renders
+	VectorImage *_prevCached;
+	VectorImage *_nextCached;
 
-	byte *_pixelData;
+	static VectorImage *_firstCached;
+	static uint32 _renderCacheSize;
+	static uint32 _renderCacheClock;
 
 	Common::String _fname;
 	uint _bgColor;
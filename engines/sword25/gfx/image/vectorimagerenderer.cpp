@@ -254,7 +254,7 @@ void art_rgb_svp_alpha1(const ArtSVP *svp,
 		art_svp_render_aa(svp, x0, y0, x1, y1, art_rgb_svp_alpha_callback1, &data);
 }
 
-static int art_vpath_len(ArtVpath *a) {
+static int art_vpath_len(const ArtVpath *a) {
 	int i = 0;
 	while (a[i].code != ART_END)
 		i++;
@@ -332,34 +332,11 @@ ArtVpath *art_vpath_reverse_free(ArtVpath *a) {
 	return dest;
 }
 
-void drawBez(ArtBpath *bez1, ArtBpath *bez2, byte *buffer, int width, int height, int deltaX, int deltaY, double scaleX, double scaleY, double penWidth, unsigned int color) {
+// Flattens the outline(s) into a single vector path, translated by (-deltaX, -deltaY)
+static ArtVpath *flattenBez(ArtBpath *bez1, ArtBpath *bez2, int deltaX, int deltaY) {
 	ArtVpath *vec = NULL;
 	ArtVpath *vec1 = NULL;
 	ArtVpath *vec2 = NULL;
-	ArtSVP *svp = NULL;
-
-#if 0
-	const char *codes[] = {"ART_MOVETO", "ART_MOVETO_OPEN", "ART_CURVETO", "ART_LINETO", "ART_END"};
-	for (int i = 0;; i++) {
-		debugN("    bez[%d].code = %s;\n", i, codes[bez[i].code]);
-		if (bez[i].code == ART_END)
-			break;
-		if (bez[i].code == ART_CURVETO) {
-			debugN("    bez[%d].x1 = %f; bez[%d].y1 = %f;\n", i, bez[i].x1, i, bez[i].y1);
-			debugN("    bez[%d].x2 = %f; bez[%d].y2 = %f;\n", i, bez[i].x2, i, bez[i].y2);
-		}
-		debugN("    bez[%d].x3 = %f; bez[%d].y3 = %f;\n", i, bez[i].x3, i, bez[i].y3);
-	}
-
-	debugN("    drawBez(bez, buffer, 1.0, 1.0, %f, 0x%08x);\n", penWidth, color);
-#endif
-
-	// HACK: Some frames have green bounding boxes drawn.
-	// Perhaps they were used by original game artist Umriss
-	// We skip them just like the original
-	if (bez2 == 0 && color == Graphics::ARGBToColor<Graphics::ColorMasks<8888> >(0xff, 0x00, 0xff, 0x00)) {
-		return;
-	}
 
 	vec1 = art_bez_path_to_vec(bez1, 0.5);
 	if (bez2 != 0) {
@@ -373,60 +350,83 @@ void drawBez(ArtBpath *bez1, ArtBpath *bez2, byte *buffer, int width, int height
 		vec = vec1;
 	}
 
+	for (ArtVpath *p = vec; p->code != ART_END; p++) {
+		p->x -= deltaX;
+		p->y -= deltaY;
+	}
+
+	return vec;
+}
+
+static ArtVpath *art_vpath_scale(const ArtVpath *vec, double scaleX, double scaleY) {
 	int size = art_vpath_len(vec);
 	ArtVpath *vect = art_new(ArtVpath, size + 1);
 	if (!vect)
-		error("[drawBez] Cannot allocate memory");
+		error("[art_vpath_scale] Cannot allocate memory");
 
 	int k;
 	for (k = 0; k < size; k++) {
 		vect[k].code = vec[k].code;
-		vect[k].x = (vec[k].x - deltaX) * scaleX;
-		vect[k].y = (vec[k].y - deltaY) * scaleY;
+		vect[k].x = vec[k].x * scaleX;
+		vect[k].y = vec[k].y * scaleY;
 	}
 	vect[k].code = ART_END;
 
-	if (bez2 == 0) { // Line drawing
-		svp = art_svp_vpath_stroke(vect, ART_PATH_STROKE_JOIN_ROUND, ART_PATH_STROKE_CAP_ROUND, penWidth, 1.0, 0.5);
-	} else {
-		svp = art_svp_from_vpath(vect);
-		art_svp_make_convex(svp);
-	}
-
-	art_rgb_svp_alpha1(svp, 0, 0, width, height, color, buffer, width * 4);
-
-	free(vect);
-	art_svp_free(svp);
-	free(vec);
+	return vect;
 }
 
-void VectorImage::render(int width, int height) {
-	double scaleX = (width == - 1) ? 1 : static_cast<double>(width) / static_cast<double>(getWidth());
-	double scaleY = (height == - 1) ? 1 : static_cast<double>(height) / static_cast<double>(getHeight());
-
-	debug(3, "VectorImage::render(%d, %d) %s", width, height, _fname.c_str());
+// Scaling by positive factors keeps the segments monotonic and their sort
+// order intact, so a sorted vector path can be scaled after the fact.
+static ArtSVP *art_svp_scale(const ArtSVP *svp, double scaleX, double scaleY) {
+	ArtSVP *dest = (ArtSVP *)malloc(sizeof(ArtSVP) + MAX(svp->n_segs - 1, 0) * sizeof(ArtSVPSeg));
+	if (!dest)
+		error("[art_svp_scale] Cannot allocate memory");
+
+	dest->n_segs = svp->n_segs;
+	for (int i = 0; i < svp->n_segs; i++) {
+		const ArtSVPSeg &src = svp->segs[i];
+		ArtSVPSeg &seg = dest->segs[i];
+
+		seg.n_points = src.n_points;
+		seg.dir = src.dir;
+		seg.bbox.x0 = src.bbox.x0 * scaleX;
+		seg.bbox.x1 = src.bbox.x1 * scaleX;
+		seg.bbox.y0 = src.bbox.y0 * scaleY;
+		seg.bbox.y1 = src.bbox.y1 * scaleY;
+		seg.points = art_new(ArtPoint, src.n_points);
+		if (!seg.points)
+			error("[art_svp_scale] Cannot allocate memory");
+
+		for (int k = 0; k < src.n_points; k++) {
+			seg.points[k].x = src.points[k].x * scaleX;
+			seg.points[k].y = src.points[k].y * scaleY;
+		}
+	}
 
-	if (_pixelData)
-		free(_pixelData);
+	return dest;
+}
 
-	_pixelData = (byte *)malloc(width * height * 4);
-	memset(_pixelData, 0, width * height * 4);
+void VectorImage::prepareShapes() {
+	if (_shapesPrepared)
+		return;
 
 	for (uint e = 0; e < _elements.size(); e++) {
+		VectorImageElement &element = _elements[e];
 
-		//// Draw shapes
-		for (uint s = 0; s < _elements[e].getFillStyleCount(); s++) {
+		//// Fill shapes
+		element._fillShapes.resize(element.getFillStyleCount());
+		for (uint s = 0; s < element.getFillStyleCount(); s++) {
 			int fill0len = 0;
 			int fill1len = 0;
 
 			// Count vector sizes in order to minimize memory
 			// fragmentation
-			for (uint p = 0; p < _elements[e].getPathCount(); p++) {
-				if (_elements[e].getPathInfo(p).getFillStyle0() == s + 1)
-					fill0len += _elements[e].getPathInfo(p).getVecLen();
+			for (uint p = 0; p < element.getPathCount(); p++) {
+				if (element.getPathInfo(p).getFillStyle0() == s + 1)
+					fill0len += element.getPathInfo(p).getVecLen();
 
-				if (_elements[e].getPathInfo(p).getFillStyle1() == s + 1)
-					fill1len += _elements[e].getPathInfo(p).getVecLen();
+				if (element.getPathInfo(p).getFillStyle1() == s + 1)
+					fill1len += element.getPathInfo(p).getVecLen();
 			}
 
 			// Now lump together vectors
@@ -435,15 +435,15 @@ void VectorImage::render(int width, int height) {
 			ArtBpath *fill1pos = fill1;
 			ArtBpath *fill0pos = fill0;
 
-			for (uint p = 0; p < _elements[e].getPathCount(); p++) {
-				if (_elements[e].getPathInfo(p).getFillStyle0() == s + 1) {
-					for (int i = 0; i < _elements[e].getPathInfo(p).getVecLen(); i++)
-						*fill0pos++ = _elements[e].getPathInfo(p).getVec()[i];
+			for (uint p = 0; p < element.getPathCount(); p++) {
+				if (element.getPathInfo(p).getFillStyle0() == s + 1) {
+					for (int i = 0; i < element.getPathInfo(p).getVecLen(); i++)
+						*fill0pos++ = element.getPathInfo(p).getVec()[i];
 				}
 
-				if (_elements[e].getPathInfo(p).getFillStyle1() == s + 1) {
-					for (int i = 0; i < _elements[e].getPathInfo(p).getVecLen(); i++)
-						*fill1pos++ = _elements[e].getPathInfo(p).getVec()[i];
+				if (element.getPathInfo(p).getFillStyle1() == s + 1) {
+					for (int i = 0; i < element.getPathInfo(p).getVecLen(); i++)
+						*fill1pos++ = element.getPathInfo(p).getVec()[i];
 				}
 			}
 
@@ -451,25 +451,80 @@ void VectorImage::render(int width, int height) {
 			(*fill0pos).code = ART_END;
 			(*fill1pos).code = ART_END;
 
-			drawBez(fill1, fill0, _pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, -1, _elements[e].getFillStyleColor(s));
+			ArtVpath *vec = flattenBez(fill1, fill0, _boundingBox.left, _boundingBox.top);
+			element._fillShapes[s] = art_svp_from_vpath(vec);
+			art_svp_make_convex(element._fillShapes[s]);
 
+			free(vec);
 			free(fill0);
 			free(fill1);
 		}
 
+		//// Stroke outlines
+		element._strokeShapes.resize(element.getPathCount());
+		for (uint p = 0; p < element.getPathCount(); p++) {
+			element._strokeShapes[p] = 0;
+
+			uint lineStyle = element.getPathInfo(p).getLineStyle();
+			if (lineStyle == 0 || lineStyle > element.getLineStyleCount())
+				continue;
+
+			// HACK: Some frames have green bounding boxes drawn.
+			// Perhaps they were used by original game artist Umriss
+			// We skip them just like the original
+			if (element.getLineStyleColor(lineStyle - 1) == Graphics::ARGBToColor<Graphics::ColorMasks<8888> >(0xff, 0x00, 0xff, 0x00))
+				continue;
+
+			element._strokeShapes[p] = flattenBez(element.getPathInfo(p).getVec(), 0, _boundingBox.left, _boundingBox.top);
+		}
+	}
+
+	_shapesPrepared = true;
+}
+
+byte *VectorImage::render(int width, int height) {
+	double scaleX = (width == - 1) ? 1 : static_cast<double>(width) / static_cast<double>(getWidth());
+	double scaleY = (height == - 1) ? 1 : static_cast<double>(height) / static_cast<double>(getHeight());
+
+	debug(3, "VectorImage::render(%d, %d) %s", width, height, _fname.c_str());
+
+	byte *pixelData = (byte *)malloc(width * height * 4);
+	memset(pixelData, 0, width * height * 4);
+
+	// The curves are flattened and the fills sorted once, only scaling and
+	// rasterizing is left for every new size
+	prepareShapes();
+
+	for (uint e = 0; e < _elements.size(); e++) {
+		const VectorImageElement &element = _elements[e];
+
+		//// Draw shapes
+		for (uint s = 0; s < element.getFillStyleCount(); s++) {
+			ArtSVP *svp = art_svp_scale(element._fillShapes[s], scaleX, scaleY);
+			art_rgb_svp_alpha1(svp, 0, 0, width, height, element.getFillStyleColor(s), pixelData, width * 4);
+			art_svp_free(svp);
+		}
+
 		//// Draw strokes
-		for (uint s = 0; s < _elements[e].getLineStyleCount(); s++) {
-			double penWidth = _elements[e].getLineStyleWidth(s);
+		for (uint s = 0; s < element.getLineStyleCount(); s++) {
+			double penWidth = element.getLineStyleWidth(s);
 			penWidth *= sqrt(fabs(scaleX * scaleY));
 
-			for (uint p = 0; p < _elements[e].getPathCount(); p++) {
-				if (_elements[e].getPathInfo(p).getLineStyle() == s + 1) {
-					drawBez(_elements[e].getPathInfo(p).getVec(), 0, _pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, penWidth, _elements[e].getLineStyleColor(s));
+			for (uint p = 0; p < element.getPathCount(); p++) {
+				if (element.getPathInfo(p).getLineStyle() == s + 1 && element._strokeShapes[p]) {
+					ArtVpath *vect = art_vpath_scale(element._strokeShapes[p], scaleX, scaleY);
+					ArtSVP *svp = art_svp_vpath_stroke(vect, ART_PATH_STROKE_JOIN_ROUND, ART_PATH_STROKE_CAP_ROUND, penWidth, 1.0, 0.5);
+
+					art_rgb_svp_alpha1(svp, 0, 0, width, height, element.getLineStyleColor(s), pixelData, width * 4);
+
+					free(vect);
+					art_svp_free(svp);
 				}
 			}
 		}
 	}
-}
 
+	return pixelData;
+}
 
 } // End of namespace Sword25
@@ -49,6 +49,7 @@
 namespace Sword25 {
 
 int RenderObject::_nextGlobalVersion = 0;
+uint RenderObject::_statesChecked = 0;
 
 RenderObject::RenderObject(RenderObjectPtr<RenderObject> parentPtr, TYPES type, uint handle) :
 	_managerPtr(0),
@@ -67,6 +68,8 @@ RenderObject::RenderObject(RenderObjectPtr<RenderObject> parentPtr, TYPES type,
 	_type(type),
 	_initSuccess(false),
 	_refreshForced(true),
+	_needsUpdate(true),
+	_childNeedsUpdate(false),
 	_handle(0),
 	_version(++_nextGlobalVersion),
 	_isSolid(false) {
@@ -95,6 +98,9 @@ RenderObject::RenderObject(RenderObjectPtr<RenderObject> parentPtr, TYPES type,
 
 	updateObjectState();
 
+	// Subclasses only set up their size once this constructor is done
+	markForUpdate();
+
 	_initSuccess = true;
 }
 
@@ -164,36 +170,62 @@ void RenderObject::validateObject() {
 	_refreshForced = false;
 }
 
-bool RenderObject::updateObjectState() {
+bool RenderObject::updateObjectState(bool forceAll) {
+	bool changed = false;
+
 	// If the object has changed, the internal state must be recalculated and possibly
 	// update Regions be registered for the next frame.
-	if ((calcBoundingBox() != _oldBbox) ||
-	        (_visible != _oldVisible) ||
-	        (_x != _oldX) ||
-	        (_y != _oldY) ||
-	        (_z != _oldZ) ||
-	        _refreshForced) {
-		if (_parentPtr.isValid())
-			_parentPtr->signalChildChange();
-
-		// Die Bounding-Box neu berechnen und Update-Regions registrieren.
-		updateBoxes();
-
-		++_version;
-
-		// nderungen Validieren
-		validateObject();
+	if (forceAll || _needsUpdate) {
+		++_statesChecked;
+
+		if ((calcBoundingBox() != _oldBbox) ||
+		        (_visible != _oldVisible) ||
+		        (_x != _oldX) ||
+		        (_y != _oldY) ||
+		        (_z != _oldZ) ||
+		        _refreshForced) {
+			// The render order of the siblings only depends on Z and Y
+			if (_parentPtr.isValid() && (_y != _oldY || _z != _oldZ))
+				_parentPtr->signalChildChange();
+
+			// Die Bounding-Box neu berechnen und Update-Regions registrieren.
+			updateBoxes();
+
+			++_version;
+
+			// nderungen Validieren
+			validateObject();
+
+			changed = true;
+		}
 	}
 
-	// Dann muss der Objektstatus der Kinder aktualisiert werden.
-	RENDEROBJECT_ITER it = _children.begin();
-	for (; it != _children.end(); ++it)
-		if (!(*it)->updateObjectState())
-			return false;
+	// Dann muss der Objektstatus der Kinder aktualisiert werden. If this object changed, all of
+	// them need checking, since their position and clipping depend on it.
+	if (forceAll || changed || _childNeedsUpdate) {
+		RENDEROBJECT_ITER it = _children.begin();
+		for (; it != _children.end(); ++it)
+			if (!(*it)->updateObjectState(forceAll || changed))
+				return false;
+	}
+
+	_needsUpdate = false;
+	_childNeedsUpdate = false;
 
 	return true;
 }
 
+void RenderObject::markForUpdate() {
+	_needsUpdate = true;
+
+	// Let the ancestors know, stopping at the first which already does
+	RenderObject *parent = _parentPtr.operator->();
+	while (parent && !parent->_childNeedsUpdate) {
+		parent->_childNeedsUpdate = true;
+		parent = parent->_parentPtr.operator->();
+	}
+}
+
 void RenderObject::updateBoxes() {
 	_bbox = calcBoundingBox();
 }
@@ -297,16 +329,19 @@ void RenderObject::setPos(int x, int y) {
 	_x = x;
 	_y = y;
 	updateAbsolutePos();
+	markForUpdate();
 }
 
 void RenderObject::setX(int x) {
 	_x = x;
 	updateAbsolutePos();
+	markForUpdate();
 }
 
 void RenderObject::setY(int y) {
 	_y = y;
 	updateAbsolutePos();
+	markForUpdate();
 }
 
 void RenderObject::setZ(int z) {
@@ -315,11 +350,13 @@ void RenderObject::setZ(int z) {
 	else {
 		_z = z;
 		updateAbsolutePos();
+		markForUpdate();
 	}
 }
 
 void RenderObject::setVisible(bool visible) {
 	_visible = visible;
+	markForUpdate();
 }
 
 RenderObjectPtr<Animation> RenderObject::addAnimation(const Common::String &filename) {
@@ -453,6 +490,7 @@ bool RenderObject::unpersist(InputPersistenceBlock &reader) {
 
 	updateAbsolutePos();
 	updateObjectState();
+	markForUpdate();
 
 	return reader.isGood();
 }
@@ -230,8 +230,9 @@ public:
 	           Hierbei werden alle Dirty-Rectangles berechnet und die Renderreihenfolge aktualisiert.
 	    @return Gibt false zurck, falls ein Fehler aufgetreten ist.
 	    @remark Diese Methode darf nur von BS_RenderObjectManager aufgerufen werden.
+	    @param forceAll if true, every object gets checked, not only those marked as possibly changed
 	 */
-	bool updateObjectState();
+	bool updateObjectState(bool forceAll = false);
 	/**
 	    @brief Lscht alle Kinderobjekte.
 	*/
@@ -355,6 +356,7 @@ public:
 	*/
 	void forceRefresh() {
 		_refreshForced = true;
+		markForUpdate();
 	}
 	/**
 	    @brief Gibt das Handle des Objekte zurck.
@@ -368,6 +370,13 @@ public:
 		return _version;
 	}
 
+	// Returns how many objects had their state checked by updateObjectState() since the last call
+	static uint takeStatesChecked() {
+		uint count = _statesChecked;
+		_statesChecked = 0;
+		return count;
+	}
+
 	bool isSolid() const {
 		return _isSolid;
 	}
@@ -411,6 +420,8 @@ protected:
 
 	static int _nextGlobalVersion;
 
+	static uint _statesChecked;
+
 	int32 _version;
 
 	// This should be set to true if the RenderObject is NOT alpha-blended to optimize drawing
@@ -475,8 +486,18 @@ private:
 	/// Ist true, wenn das Objekt in nchsten Frame neu gezeichnet werden soll
 	bool _refreshForced;
 
+	// Set when the object's state may have changed since the last updateObjectState(), and on its
+	// ancestors when that is the case for any object below them. Unmarked subtrees don't get checked.
+	bool _needsUpdate;
+	bool _childNeedsUpdate;
+
 	uint32 _handle;
 
+	/**
+	    @brief Marks the object to have its state checked in the next frame.
+	*/
+	void markForUpdate();
+
 	/**
 	    @brief Entfernt ein Objekt aus der Kinderliste.
 	    @param pObject ein Pointer auf das zu entfernende Objekt
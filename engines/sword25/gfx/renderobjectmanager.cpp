@@ -31,6 +31,7 @@
 
 #include "sword25/gfx/renderobjectmanager.h"
 
+#include "sword25/sword25.h"
 #include "sword25/kernel/kernel.h"
 #include "sword25/kernel/inputpersistenceblock.h"
 #include "sword25/kernel/outputpersistenceblock.h"
@@ -46,20 +47,27 @@
 namespace Sword25 {
 
 void RenderObjectQueue::add(RenderObject *renderObject) {
-	push_back(RenderObjectQueueItem(renderObject, renderObject->getBbox(), renderObject->getVersion()));
+	RenderObjectQueueItem item(renderObject, renderObject->getBbox(), renderObject->getVersion());
+	push_back(item);
+	_items[renderObject] = item;
 }
 
 bool RenderObjectQueue::exists(const RenderObjectQueueItem &renderObjectQueueItem) {
-	for (RenderObjectQueue::iterator it = begin(); it != end(); ++it)
-		if ((*it)._renderObject == renderObjectQueueItem._renderObject &&
-			(*it)._version == renderObjectQueueItem._version && 
-			(*it)._bbox == renderObjectQueueItem._bbox)
-			return true;
-	return false;
+	ItemMap::const_iterator it = _items.find(renderObjectQueueItem._renderObject);
+	return it != _items.end() &&
+		it->_value._version == renderObjectQueueItem._version &&
+		it->_value._bbox == renderObjectQueueItem._bbox;
+}
+
+void RenderObjectQueue::clear() {
+	Common::List<RenderObjectQueueItem>::clear();
+	_items.clear();
 }
 
 RenderObjectManager::RenderObjectManager(int width, int height, int framebufferCount) :
-	_frameStarted(false) {
+	_frameStarted(false), _fullUpdate(false) {
+	resetFrameStats();
+
 	// Wurzel des BS_RenderObject-Baumes erzeugen.
 	_rootPtr = (new RootRenderObject(this, width, height))->getHandle();
 	_uta = new MicroTileArray(width, height);
@@ -88,14 +96,18 @@ void RenderObjectManager::startFrame() {
 }
 
 bool RenderObjectManager::render() {
+	uint32 startTime = g_system->getMillis();
+
 	// Den Objekt-Status des Wurzelobjektes aktualisieren. Dadurch werden rekursiv alle Baumelemente aktualisiert.
 	// Beim aktualisieren des Objekt-Status werden auch die Update-Rects gefunden, so dass feststeht, was neu gezeichnet
 	// werden muss.
-	if (!_rootPtr.isValid() || !_rootPtr->updateObjectState())
+	if (!_rootPtr.isValid() || !_rootPtr->updateObjectState(_fullUpdate))
 		return false;
 
 	_frameStarted = false;
 
+	uint32 queueStartTime = g_system->getMillis();
+
 	// Die Render-Methode der Wurzel aufrufen. Dadurch wird das rekursive Rendern der Baumelemente angestoen.
 
 	_currQueue->clear();
@@ -135,6 +147,8 @@ bool RenderObjectManager::render() {
 		updateRectsMinZ.push_back(minZ);
 	}
 
+	uint32 renderStartTime = g_system->getMillis();
+
 	if (_rootPtr->render(updateRects, updateRectsMinZ)) {
 		// Copy updated rectangles to the video screen
 		Graphics::Surface *backSurface = Kernel::getInstance()->getGfx()->getSurface();
@@ -147,6 +161,21 @@ bool RenderObjectManager::render() {
 		}
 	}
 
+	uint32 endTime = g_system->getMillis();
+	uint checked = RenderObject::takeStatesChecked();
+
+	_frameStats.frames++;
+	_frameStats.objects += _currQueue->count();
+	_frameStats.checked += checked;
+	_frameStats.updateRects += updateRects->size();
+	_frameStats.updateTime += queueStartTime - startTime;
+	_frameStats.queueTime += renderStartTime - queueStartTime;
+	_frameStats.renderTime += endTime - renderStartTime;
+
+	debugC(kDebugRender, "Frame: %u objects, %u checked, %u update rects, %ums update, %ums queue, %ums render",
+		_currQueue->count(), checked, updateRects->size(),
+		queueStartTime - startTime, renderStartTime - queueStartTime, endTime - renderStartTime);
+
 	delete updateRects;
 
 	SWAP(_currQueue, _prevQueue);
@@ -154,6 +183,10 @@ bool RenderObjectManager::render() {
 	return true;
 }
 
+void RenderObjectManager::resetFrameStats() {
+	memset(&_frameStats, 0, sizeof(_frameStats));
+}
+
 void RenderObjectManager::attatchTimedRenderObject(RenderObjectPtr<TimedRenderObject> renderObjectPtr) {
 	_timedRenderObjects.push_back(renderObjectPtr);
 }
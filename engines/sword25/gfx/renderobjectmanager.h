@@ -43,6 +43,8 @@
 #define SWORD25_RENDEROBJECTMANAGER_H
 
 #include "common/rect.h"
+#include "common/hashmap.h"
+#include "common/hash-ptr.h"
 #include "sword25/kernel/common.h"
 #include "sword25/gfx/renderobjectptr.h"
 #include "sword25/kernel/persistable.h"
@@ -60,6 +62,7 @@ struct RenderObjectQueueItem {
 	RenderObject *_renderObject;
 	Common::Rect _bbox;
 	int _version;
+	RenderObjectQueueItem() : _renderObject(0), _version(0) {}
 	RenderObjectQueueItem(RenderObject *renderObject, const Common::Rect &bbox, int version)
 		: _renderObject(renderObject), _bbox(bbox), _version(version) {}
 };
@@ -68,6 +71,16 @@ class RenderObjectQueue : public Common::List<RenderObjectQueueItem> {
 public:
 	void add(RenderObject *renderObject);
 	bool exists(const RenderObjectQueueItem &renderObjectQueueItem);
+	void clear();
+
+	uint count() const {
+		return _items.size();
+	}
+
+private:
+	// The queued items by object, so that exists() doesn't need to search the whole queue
+	typedef Common::HashMap<const RenderObject *, RenderObjectQueueItem> ItemMap;
+	ItemMap _items;
 };
 
 /**
@@ -126,8 +139,41 @@ public:
 	virtual bool persist(OutputPersistenceBlock &writer);
 	virtual bool unpersist(InputPersistenceBlock &reader);
 
+	/**
+	    @brief Timings and object counts, summed over the frames rendered since the last reset.
+	*/
+	struct FrameStats {
+		uint frames;
+		uint objects;       ///< Objects in the render queue
+		uint checked;       ///< Objects whose state got checked
+		uint updateRects;
+		uint32 updateTime;  ///< Milliseconds spent checking object states
+		uint32 queueTime;   ///< Milliseconds spent building and comparing the render queues
+		uint32 renderTime;  ///< Milliseconds spent drawing and copying to the screen
+	};
+
+	const FrameStats &getFrameStats() const {
+		return _frameStats;
+	}
+
+	void resetFrameStats();
+
+	/**
+	    @brief Sets whether the state of every object gets checked each frame, rather than only
+	           of those marked as possibly changed. Meant for comparing the cost of both.
+	*/
+	void setFullUpdate(bool fullUpdate) {
+		_fullUpdate = fullUpdate;
+	}
+
+	bool getFullUpdate() const {
+		return _fullUpdate;
+	}
+
 private:
 	bool _frameStarted;
+	bool _fullUpdate;
+	FrameStats _frameStats;
 	typedef Common::Array<RenderObjectPtr<TimedRenderObject> > RenderObjectList;
 	RenderObjectList _timedRenderObjects;
 
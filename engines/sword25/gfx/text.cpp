@@ -32,7 +32,7 @@
 #include "sword25/kernel/kernel.h"
 #include "sword25/kernel/outputpersistenceblock.h"
 #include "sword25/kernel/inputpersistenceblock.h"
-#include "sword25/kernel/resmanager.h"	// for PRECACHE_RESOURCES
+#include "sword25/kernel/resmanager.h"
 #include "sword25/gfx/fontresource.h"
 #include "sword25/gfx/bitmapresource.h"
 
@@ -65,26 +65,12 @@ Text::Text(InputPersistenceBlock &reader, RenderObjectPtr<RenderObject> parentPt
 
 bool Text::setFont(const Common::String &font) {
 	// Load font
-
-#ifdef PRECACHE_RESOURCES
-	if (getResourceManager()->precacheResource(font)) {
-		_font = font;
-		updateFormat();
-		forceRefresh();
-		return true;
-	} else {
-		error("Could not precache font \"%s\". Font probably does not exist.", font.c_str());
-		return false;
-	}
-#else
 	Resource *pResource = getResourceManager()->requestResource(font);
 	pResource->release(); //unlock precached resource
 	_font = font;
 	updateFormat();
 	forceRefresh();
 	return true;
-#endif
-
 }
 
 void Text::setText(const Common::String &text) {
@@ -310,11 +310,9 @@ static int precacheResource(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-#ifdef PRECACHE_RESOURCES
-	lua_pushbooleancpp(L, pResource->precacheResource(luaL_checkstring(L, 1)));
-#else
+	// Loaded in the background, see ResourceManager::processPrecacheQueue()
+	pResource->queuePrecache(luaL_checkstring(L, 1));
 	lua_pushbooleancpp(L, true);
-#endif
 
 	return 1;
 }
@@ -325,11 +323,8 @@ static int forcePrecacheResource(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-#ifdef PRECACHE_RESOURCES
-	lua_pushbooleancpp(L, pResource->precacheResource(luaL_checkstring(L, 1), true));
-#else
+	pResource->queuePrecache(luaL_checkstring(L, 1), true);
 	lua_pushbooleancpp(L, true);
-#endif
 
 	return 1;
 }
@@ -340,9 +335,7 @@ static int getMaxMemoryUsage(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-	// This is used for debugging, so it doesn't really matter.
-	// The default value set by the scripts is 256000000 bytes
-	lua_pushnumber(L, 256000000);
+	lua_pushnumber(L, pResource->getMaxMemoryUsage());
 
 	return 1;
 }
@@ -353,8 +346,7 @@ static int setMaxMemoryUsage(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-	// This call is ignored, we set a limit on the number of
-	// simultaneous resources loaded instead.
+	pResource->setMaxMemoryUsage((uint32)luaL_checknumber(L, 1));
 
 	return 0;
 }
@@ -407,6 +407,9 @@ bool PersistenceService::loadGame(uint slotID) {
 
 	InputPersistenceBlock reader(&uncompressedDataBuffer[0], curSavegameInfo.gamedataUncompressedLength, curSavegameInfo.version);
 
+	// Files queued for precaching belong to the scene being left
+	Kernel::getInstance()->getResourceManager()->clearPrecacheQueue();
+
 	// Einzelne Engine-Module depersistieren.
 	bool success = true;
 	success &= Kernel::getInstance()->getScript()->unpersist(reader);
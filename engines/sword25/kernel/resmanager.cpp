@@ -35,17 +35,35 @@
 #include "sword25/kernel/resservice.h"
 #include "sword25/package/packagemanager.h"
 
+#include "common/config-manager.h"
+#include "common/system.h"
+
 namespace Sword25 {
 
-// Sets the amount of resources that are simultaneously loaded.
-// This needs to be a relatively high number, as all the animation
-// frames in each scene are loaded as separate resources.
-// Also, George's walk states are all loaded here (150 files)
-#define SWORD25_RESOURCECACHE_MIN 400
-// The maximum number of loaded resources. If more than these resources
-// are loaded, the resource manager will start purging resources till it
-// hits the minimum limit above
-#define SWORD25_RESOURCECACHE_MAX 500
+// The default amount of memory the loaded resources may occupy. This
+// needs to be relatively high, as all the animation frames in each scene
+// are loaded as separate resources. Also, George's walk states are all
+// loaded here (150 files). The scripts may change it through
+// SetMaxMemoryUsage(), and the "sword25_resource_cache_size" config key
+// (in KB) caps it for low memory systems.
+#define SWORD25_RESOURCECACHE_BUDGET (128 * 1024 * 1024)
+// When the budget is exceeded, the resource manager purges resources
+// until this percentage of the budget is in use
+#define SWORD25_RESOURCECACHE_LOW_WATER 75
+
+ResourceManager::ResourceManager(Kernel *pKernel) :
+	_kernelPtr(pKernel),
+	_maxMemoryUsage(0),
+	_usedMemory(0),
+	_cacheHits(0),
+	_cacheMisses(0),
+	_evictions(0) {
+	setMaxMemoryUsage(SWORD25_RESOURCECACHE_BUDGET);
+
+	// The original engine never loaded precached resources ahead of time, so
+	// this is off unless asked for
+	_precacheEnabled = ConfMan.hasKey("sword25_precache") && ConfMan.getBool("sword25_precache");
+}
 
 ResourceManager::~ResourceManager() {
 	// Clear all unlocked resources
@@ -82,15 +100,33 @@ bool ResourceManager::registerResourceService(ResourceService *pService) {
 	return true;
 }
 
+void ResourceManager::setMaxMemoryUsage(uint32 maxMemoryUsage) {
+	_maxMemoryUsage = maxMemoryUsage;
+
+	if (ConfMan.hasKey("sword25_resource_cache_size")) {
+		// Clamp before converting, so that large values cannot overflow
+		const int cacheSize = ConfMan.getInt("sword25_resource_cache_size");
+		if (cacheSize > 0) {
+			const uint32 configured = MIN<uint32>(cacheSize, 0xFFFFFFFF / 1024) * 1024;
+			if (configured < _maxMemoryUsage)
+				_maxMemoryUsage = configured;
+		}
+	}
+
+	debugC(kDebugResource, "Resource cache budget: %u bytes", _maxMemoryUsage);
+}
+
 /**
  * Deletes resources as necessary until the specified memory limit is not being exceeded.
  */
 void ResourceManager::deleteResourcesIfNecessary() {
 	// If enough memory is available, or no resources are loaded, then the function can immediately end
-	if (_resources.size() < SWORD25_RESOURCECACHE_MAX)
+	if (_usedMemory <= _maxMemoryUsage || _resources.empty())
 		return;
 
-	// Keep deleting resources until the memory usage of the process falls below the set maximum limit.
+	const uint32 lowWater = (uint32)((uint64)_maxMemoryUsage * SWORD25_RESOURCECACHE_LOW_WATER / 100);
+
+	// Keep deleting resources until the memory usage falls below the low water mark.
 	// The list is processed backwards in order to first release those resources that have been
 	// not been accessed for the longest
 	Common::List<Resource *>::iterator iter = _resources.end();
@@ -98,16 +134,18 @@ void ResourceManager::deleteResourcesIfNecessary() {
 		--iter;
 
 		// The resource may be released only if it isn't locked
-		if ((*iter)->getLockCount() == 0)
+		if ((*iter)->getLockCount() == 0) {
 			iter = deleteResource(*iter);
-	} while (iter != _resources.begin() && _resources.size() >= SWORD25_RESOURCECACHE_MIN);
+			_evictions++;
+		}
+	} while (iter != _resources.begin() && _usedMemory > lowWater);
 
-	// Are we still above the minimum? If yes, then start releasing locked resources
+	// Are we still above the budget? If yes, then start releasing locked resources
 	// FIXME: This code shouldn't be needed at all, but it seems like there is a bug
 	// in the resource lock code, and resources are not unlocked when changing rooms.
 	// Only image/animation resources are unlocked forcibly, thus this shouldn't have
 	// any impact on the game itself.
-	if (_resources.size() <= SWORD25_RESOURCECACHE_MIN)
+	if (_usedMemory <= _maxMemoryUsage)
 		return;
 
 	iter = _resources.end();
@@ -125,14 +163,18 @@ void ResourceManager::deleteResourcesIfNecessary() {
 				(*iter)->release();
 
 			iter = deleteResource(*iter);
+			_evictions++;
 		}
-	} while (iter != _resources.begin() && _resources.size() >= SWORD25_RESOURCECACHE_MIN);
+	} while (iter != _resources.begin() && _usedMemory > lowWater);
 }
 
 /**
  * Releases all resources that are not locked.
  */
 void ResourceManager::emptyCache() {
+	// Whatever was queued belongs to the resources being dropped
+	clearPrecacheQueue();
+
 	// Scan through the resource list
 	Common::List<Resource *>::iterator iter = _resources.begin();
 	while (iter != _resources.end()) {
@@ -172,8 +214,12 @@ Resource *ResourceManager::requestResource(const Common::String &fileName) {
 	// Determine whether the resource is already loaded
 	// If the resource is found, it will be placed at the head of the resource list and returned
 	Resource *pResource = getResource(uniqueFileName);
-	if (!pResource)
+	if (pResource) {
+		_cacheHits++;
+	} else {
+		_cacheMisses++;
 		pResource = loadResource(uniqueFileName);
+	}
 	if (pResource) {
 		moveToFront(pResource);
 		(pResource)->addReference();
@@ -183,43 +229,75 @@ Resource *ResourceManager::requestResource(const Common::String &fileName) {
 	return NULL;
 }
 
-#ifdef PRECACHE_RESOURCES
-
 /**
- * Loads a resource into the cache
+ * Queues a resource to be loaded into the cache in the background
  * @param FileName      The filename of the resource to be cached
  * @param ForceReload   Indicates whether the file should be reloaded if it's already in the cache.
- * This is useful for files that may have changed in the interim
  */
-bool ResourceManager::precacheResource(const Common::String &fileName, bool forceReload) {
-	// Get the absolute path to the file
+void ResourceManager::queuePrecache(const Common::String &fileName, bool forceReload) {
+	if (!_precacheEnabled)
+		return;
+
 	Common::String uniqueFileName = getUniqueFileName(fileName);
 	if (uniqueFileName.empty())
-		return false;
+		return;
 
-	Resource *resourcePtr = getResource(uniqueFileName);
+	// Scripts ask for the same files over and over, so each file is only
+	// queued once. Files which are already loaded only need queueing when
+	// they have to be reloaded.
+	PrecacheMap::iterator it = _precacheForceReload.find(uniqueFileName);
+	if (it != _precacheForceReload.end()) {
+		it->_value |= forceReload;
+		return;
+	}
+	if (!forceReload && getResource(uniqueFileName))
+		return;
+
+	_precacheForceReload[uniqueFileName] = forceReload;
+	_precacheQueue.push_back(uniqueFileName);
+}
+
+void ResourceManager::clearPrecacheQueue() {
+	_precacheQueue.clear();
+	_precacheForceReload.clear();
+}
+
+/**
+ * Loads queued resources until the given time has elapsed. At least one resource
+ * is loaded per call, so that the queue always drains.
+ * @param maxMillis     The time that may be spent loading resources
+ */
+void ResourceManager::processPrecacheQueue(uint32 maxMillis) {
+	const uint32 start = g_system->getMillis();
+
+	while (!_precacheQueue.empty()) {
+		const Common::String uniqueFileName = _precacheQueue.front();
+		_precacheQueue.pop_front();
+		const bool forceReload = _precacheForceReload.getVal(uniqueFileName);
+		_precacheForceReload.erase(uniqueFileName);
+
+		Resource *resourcePtr = getResource(uniqueFileName);
+
+		if (forceReload && resourcePtr) {
+			if (resourcePtr->getLockCount()) {
+				debugC(kDebugResource, "Could not force precaching of \"%s\". The resource is locked.", uniqueFileName.c_str());
+				continue;
+			}
 
-	if (forceReload && resourcePtr) {
-		if (resourcePtr->getLockCount()) {
-			error("Could not force precaching of \"%s\". The resource is locked.", fileName.c_str());
-			return false;
-		} else {
 			deleteResource(resourcePtr);
 			resourcePtr = 0;
 		}
-	}
 
-	if (!resourcePtr && loadResource(uniqueFileName) == NULL) {
-		// This isn't fatal - e.g. it can happen when loading saved games
-		debugC(kDebugResource, "Could not precache \"%s\",", fileName.c_str());
-		return false;
-	}
+		if (!resourcePtr && loadResource(uniqueFileName) == NULL) {
+			// This isn't fatal - e.g. it can happen when loading saved games
+			debugC(kDebugResource, "Could not precache \"%s\",", uniqueFileName.c_str());
+		}
 
-	return true;
+		if (g_system->getMillis() - start >= maxMillis)
+			break;
+	}
 }
 
-#endif
-
 /**
  * Moves a resource to the top of the resource list
  * @param pResource     The resource
@@ -260,6 +338,10 @@ Resource *ResourceManager::loadResource(const Common::String &fileName) {
 			// Also store the resource in the hash table for quick lookup
 			_resourceHashMap[pResource->getFileName()] = pResource;
 
+			// Charge the resource against the cache budget
+			pResource->_accountedMemory = pResource->getMemoryUsage();
+			_usedMemory += pResource->_accountedMemory;
+
 			return pResource;
 		}
 	}
@@ -296,6 +378,8 @@ Common::List<Resource *>::iterator ResourceManager::deleteResource(Resource *pRe
 	// Remove the resource from the hash table
 	_resourceHashMap.erase(pResource->_fileName);
 
+	_usedMemory -= pResource->_accountedMemory;
+
 	// Delete the resource from the resource list
 	Common::List<Resource *>::iterator result = _resources.erase(pResource->_iterator);
 
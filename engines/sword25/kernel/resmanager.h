@@ -40,8 +40,6 @@
 
 namespace Sword25 {
 
-//#define PRECACHE_RESOURCES
-
 class ResourceService;
 class Resource;
 class Kernel;
@@ -56,15 +54,61 @@ public:
 	 */
 	Resource *requestResource(const Common::String &fileName);
 
-#ifdef PRECACHE_RESOURCES
 	/**
-	 * Loads a resource into the cache
+	 * Queues a resource to be loaded into the cache in the background. Does
+	 * nothing unless the "sword25_precache" config key is set.
 	 * @param FileName      The filename of the resource to be cached
 	 * @param ForceReload   Indicates whether the file should be reloaded if it's already in the cache.
-	 * This is useful for files that may have changed in the interim
 	 */
-	bool precacheResource(const Common::String &fileName, bool forceReload = false);
-#endif
+	void queuePrecache(const Common::String &fileName, bool forceReload = false);
+
+	/**
+	 * Drops all queued precache requests
+	 */
+	void clearPrecacheQueue();
+
+	uint getPrecacheQueueSize() const {
+		return _precacheQueue.size();
+	}
+
+	/**
+	 * Loads queued resources until the given time has elapsed. Called once per frame.
+	 * @param maxMillis     The time that may be spent loading resources
+	 */
+	void processPrecacheQueue(uint32 maxMillis);
+
+	/**
+	 * Sets the number of bytes the unlocked resources may occupy
+	 */
+	void setMaxMemoryUsage(uint32 maxMemoryUsage);
+
+	uint32 getMaxMemoryUsage() const {
+		return _maxMemoryUsage;
+	}
+
+	/**
+	 * Returns the number of bytes charged for all loaded resources
+	 */
+	uint32 getUsedMemory() const {
+		return _usedMemory;
+	}
+
+	/**
+	 * Returns the loaded resources, most recently used first
+	 */
+	const Common::List<Resource *> &getResources() const {
+		return _resources;
+	}
+
+	uint32 getCacheHits() const {
+		return _cacheHits;
+	}
+	uint32 getCacheMisses() const {
+		return _cacheMisses;
+	}
+	uint32 getEvictions() const {
+		return _evictions;
+	}
 
 	/**
 	 * Registers a RegisterResourceService. This method is the constructor of
@@ -93,9 +137,7 @@ private:
 	 * Creates a new resource manager
 	 * Only the BS_Kernel class can generate copies this class. Thus, the constructor is private
 	 */
-	ResourceManager(Kernel *pKernel) :
-		_kernelPtr(pKernel)
-	{}
+	ResourceManager(Kernel *pKernel);
 	virtual ~ResourceManager();
 
 	/**
@@ -139,6 +181,19 @@ private:
 	Common::List<Resource *> _resources;
 	typedef Common::HashMap<Common::String, Resource *> ResMap;
 	ResMap _resourceHashMap;
+
+	// Unique file names waiting to be precached, and whether each of them
+	// has to be reloaded
+	Common::List<Common::String> _precacheQueue;
+	typedef Common::HashMap<Common::String, bool> PrecacheMap;
+	PrecacheMap _precacheForceReload;
+	bool _precacheEnabled;
+
+	uint32 _maxMemoryUsage;
+	uint32 _usedMemory;
+	uint32 _cacheHits;
+	uint32 _cacheMisses;
+	uint32 _evictions;
 };
 
 } // End of namespace Sword25
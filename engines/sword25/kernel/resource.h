@@ -92,6 +92,14 @@ public:
 		return _type;
 	}
 
+	/**
+	 * Returns the approximate number of bytes the resource occupies, which is
+	 * charged against the resource cache budget
+	 */
+	virtual uint getMemoryUsage() const {
+		return 0;
+	}
+
 protected:
 	virtual ~Resource() {}
 
@@ -99,6 +107,7 @@ private:
 	Common::String _fileName;          ///< The absolute filename
 	uint _refCount;          ///< The number of locks
 	uint _type;              ///< The type of the resource
+	uint _accountedMemory;   ///< The memory usage charged when the resource was loaded
 	Common::List<Resource *>::iterator _iterator;        ///< Points to the resource position in the LRU list
 };
 
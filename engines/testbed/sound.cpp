@@ -20,6 +20,7 @@
  *
  */
 
+#include "audio/fmopl.h"
 #include "audio/softsynth/pcspk.h"
 
 #include "backends/audiocd/audiocd.h"
@@ -261,6 +262,67 @@ TestExitStatus SoundSubsystem::sampleRates() {
 	return passed;
 }
 
+TestExitStatus SoundSubsystem::oplBenchmark() {
+	// Two sounding notes, so the emulators do more than render silence
+	static const byte oplSetup[][2] = {
+		{ 0x01, 0x20 }, { 0x20, 0x01 }, { 0x23, 0x01 }, { 0x40, 0x10 }, { 0x43, 0x00 },
+		{ 0x60, 0xf0 }, { 0x63, 0xf4 }, { 0x80, 0x77 }, { 0x83, 0x77 }, { 0xc0, 0x0e },
+		{ 0x21, 0xa1 }, { 0x24, 0x61 }, { 0x41, 0x1a }, { 0x44, 0x00 }, { 0x61, 0xf2 },
+		{ 0x64, 0xa4 }, { 0x81, 0x53 }, { 0x84, 0x26 }, { 0xc1, 0x3b },
+		{ 0xa0, 0x98 }, { 0xb0, 0x31 }, { 0xa1, 0x6b }, { 0xb1, 0x2d }
+	};
+	static const char *const emulators[] = { "mame", "db", "nuked" };
+	const int seconds = 5;
+
+	TestExitStatus passed = kTestPassed;
+	int16 buffer[1024];
+
+	for (uint i = 0; i < ARRAYSIZE(emulators); ++i) {
+		OPL::Config::DriverId id = -1;
+		for (const OPL::Config::EmulatorDescription *d = OPL::Config::getAvailable(); d->name; ++d) {
+			if (!strcmp(d->name, emulators[i]))
+				id = d->id;
+		}
+		if (id == -1) {
+			Testsuite::logPrintf("Info! OPL emulator %s is not available\n", emulators[i]);
+			continue;
+		}
+
+		OPL::OPL *opl = OPL::Config::create(id, OPL::Config::kOpl2);
+		OPL::EmulatedOPL *emulated = dynamic_cast<OPL::EmulatedOPL *>(opl);
+		if (!emulated || !opl->init()) {
+			Testsuite::logDetailedPrintf("Error! Could not create OPL emulator %s\n", emulators[i]);
+			delete opl;
+			passed = kTestFailed;
+			continue;
+		}
+
+		// No callbacks are registered, this only sets how readBuffer splits its work
+		opl->setCallbackFrequency(OPL::OPL::kDefaultCallbackFrequency);
+		for (uint j = 0; j < ARRAYSIZE(oplSetup); ++j)
+			opl->writeReg(oplSetup[j][0], oplSetup[j][1]);
+
+		const int channels = emulated->isStereo() ? 2 : 1;
+		const uint32 frames = emulated->getRate() * seconds;
+		uint32 rendered = 0;
+
+		uint32 start = g_system->getMillis();
+		while (rendered < frames) {
+			emulated->readBuffer(buffer, ARRAYSIZE(buffer));
+			rendered += ARRAYSIZE(buffer) / channels;
+		}
+		uint32 elapsed = MAX<uint32>(g_system->getMillis() - start, 1);
+
+		Testsuite::logPrintf("Info! OPL emulator %s: %u samples in %u ms, %u samples/s (%ux realtime)\n",
+			emulators[i], rendered, elapsed, (uint)((uint64)rendered * 1000 / elapsed),
+			(uint)((uint64)seconds * 1000 / elapsed));
+
+		delete opl;
+	}
+
+	return passed;
+}
+
 SoundSubsystemTestSuite::SoundSubsystemTestSuite() {
 	addTest("SimpleBeeps", &SoundSubsystem::playBeeps, true);
 	addTest("MixSounds", &SoundSubsystem::mixSounds, true);
@@ -276,6 +338,7 @@ SoundSubsystemTestSuite::SoundSubsystemTestSuite() {
 		}
 	}
 	addTest("SampleRates", &SoundSubsystem::sampleRates, true);
+	addTest("OPLBenchmark", &SoundSubsystem::oplBenchmark, false);
 }
 
 } // End of namespace Testbed
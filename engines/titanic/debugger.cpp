@@ -29,9 +29,14 @@
 #include "titanic/game/movie_tester.h"
 #include "titanic/main_game_window.h"
 #include "titanic/pet_control/pet_control.h"
+#include "titanic/star_control/star_control.h"
 #include "titanic/support/movie.h"
 #include "titanic/titanic.h"
+#include "titanic/true_talk/script_handler.h"
+#include "titanic/true_talk/tt_sentence.h"
+#include "titanic/true_talk/tt_word.h"
 #include "common/str-array.h"
+#include "common/system.h"
 
 namespace Titanic {
 
@@ -45,6 +50,8 @@ Debugger::Debugger(TitanicEngine *vm) : GUI::Debugger(), _vm(vm) {
 	registerCmd("sound",		WRAP_METHOD(Debugger, cmdSound));
 	registerCmd("cheat",        WRAP_METHOD(Debugger, cmdCheat));
 	registerCmd("frame",        WRAP_METHOD(Debugger, cmdFrame));
+	registerCmd("parse_bench",  WRAP_METHOD(Debugger, cmdParseBench));
+	registerCmd("star_bench",   WRAP_METHOD(Debugger, cmdStarBench));
 }
 
 int Debugger::strToInt(const char *s) {
@@ -371,4 +378,101 @@ bool Debugger::cmdFrame(int argc, const char **argv) {
 	}
 }
 
+bool Debugger::cmdParseBench(int argc, const char **argv) {
+	static const char *const SENTENCES[] = {
+		"Hello, how are you today?",
+		"What's the weather like on the ship?",
+		"I'd like to upgrade my cabin to first class please",
+		"Where can I find the bar?",
+		"Can you tell me where the parrot is",
+		"I don't know what you're talking about",
+		"Take me to the top of the well",
+		"What is the name of this ship",
+		"Who built the Titanic and why did it crash?",
+		"Give me a drink, I'm very thirsty",
+		"Tell me about the bomb",
+		"I want to go to the embarkation lobby",
+		"Are you a robot or a person?",
+		"Please help me find my luggage",
+		"What time does the restaurant open",
+		"Thank you, goodbye"
+	};
+	const int sentenceCount = ARRAYSIZE(SENTENCES);
+
+	CScriptHandler *scriptHandler = g_vm->_scriptHandler;
+	if (!scriptHandler) {
+		debugPrintf("TrueTalk isn't loaded\n");
+		return true;
+	}
+
+	int count = (argc >= 2) ? strToInt(argv[1]) : 100;
+	if (count <= 0) {
+		debugPrintf("parse_bench [count]\n");
+		return true;
+	}
+
+	uint preprocessTime = 0, vocabTime = 0;
+	int words = 0, hits = 0;
+	for (int ctr = 0; ctr < count; ++ctr) {
+		for (int idx = 0; idx < sentenceCount; ++idx) {
+			TTsentence sentence(0, TTstring(SENTENCES[idx]), scriptHandler, nullptr, nullptr);
+
+			uint32 startTime = g_system->getMillis();
+			scriptHandler->_parser.preprocess(&sentence);
+			uint32 midTime = g_system->getMillis();
+
+			// Look up each of the words like the parser does when finding frames
+			TTstring *line = sentence._normalizedLine.copy();
+			for (;;) {
+				TTstring wordString = line->tokenize(" \n");
+				if (wordString.empty())
+					break;
+
+				TTword *word = scriptHandler->_vocab->getWord(wordString);
+				++words;
+				if (word) {
+					++hits;
+					word->deleteSiblings();
+					delete word;
+				}
+			}
+			delete line;
+
+			preprocessTime += midTime - startTime;
+			vocabTime += g_system->getMillis() - midTime;
+		}
+	}
+
+	debugPrintf("%d sentences, %d words (%d found in vocab)\n",
+		count * sentenceCount, words, hits);
+	debugPrintf("Preprocessing: %ums, vocab lookups: %ums\n", preprocessTime, vocabTime);
+	return true;
+}
+
+bool Debugger::cmdStarBench(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("star_bench [<frames>]\n");
+		return true;
+	}
+
+	int frames = (argc == 2) ? strToInt(argv[1]) : 100;
+	CViewItem *view = g_vm->_window->_gameManager->getView();
+	CStarControl *starControl = view ? dynamic_cast<CStarControl *>(
+		view->findChildInstanceOf(CStarControl::_type)) : nullptr;
+
+	if (!starControl || !starControl->isStarFieldMode()) {
+		debugPrintf("The starfield isn't being shown\n");
+		return true;
+	}
+	if (frames <= 0) {
+		debugPrintf("Nothing to do\n");
+		return true;
+	}
+
+	// Rendered from the current camera position, so different views can be compared
+	uint32 time = starControl->timeRender(frames);
+	debugPrintf("%d frames: %ums, %.2fms/frame\n", frames, time, (double)time / frames);
+	return true;
+}
+
 } // End of namespace Titanic
@@ -120,6 +120,16 @@ private:
 	 * Set the movie frame for a given object
 	 */
 	bool cmdFrame(int argc, const char **argv);
+
+	/**
+	 * Times preprocessing and vocab lookups for a set of sample sentences
+	 */
+	bool cmdParseBench(int argc, const char **argv);
+
+	/**
+	 * Times rendering the starfield of the current view
+	 */
+	bool cmdStarBench(int argc, const char **argv);
 protected:
 	TitanicEngine *_vm;
 public:
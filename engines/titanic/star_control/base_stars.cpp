@@ -60,11 +60,13 @@ bool CBaseStarEntry::operator==(const CBaseStarEntry &s) const {
 /*------------------------------------------------------------------------*/
 
 CBaseStars::CBaseStars() : _minVal(0.0), _maxVal(1.0), _range(0.0),
-		_value1(0.0), _value2(0.0), _value3(0.0), _value4(0.0) {
+		_value1(0.0), _value2(0.0), _value3(0.0), _value4(0.0),
+		_starBufferDirty(true) {
 }
 
 void CBaseStars::clear() {
 	_data.clear();
+	dataChanged();
 }
 
 void CBaseStars::initialize() {
@@ -102,6 +104,7 @@ void CBaseStars::loadData(Common::SeekableReadStream &s) {
 	// Iterate through reading the data for each entry
 	for (uint idx = 0; idx < count; ++idx)
 		_data[idx].load(s);
+	dataChanged();
 }
 
 void CBaseStars::loadData(const CString &resName) {
@@ -126,6 +129,57 @@ void CBaseStars::resetEntry(CBaseStarEntry &entry) {
 		entry._data[idx] = 0;
 }
 
+void CBaseStars::updateStarBuffer() {
+	uint count = _data.size();
+	_starX.resize(count);
+	_starY.resize(count);
+	_starZ.resize(count);
+	_starDepth.resize(count);
+	_transformed.resize(count);
+
+	for (uint idx = 0; idx < count; ++idx) {
+		const FVector &pos = _data[idx]._position;
+		_starX[idx] = pos._x;
+		_starY[idx] = pos._y;
+		_starZ[idx] = pos._z;
+	}
+
+	_starBufferDirty = false;
+}
+
+uint CBaseStars::transformStars(const FPose &pose, double minZ) {
+	if (_starBufferDirty)
+		updateStarBuffer();
+
+	uint count = _data.size();
+	if (!count)
+		return 0;
+
+	// Work out the depth of all the stars first. With the positions held in
+	// separate arrays this is a simple loop the compiler can vectorize
+	const float *xP = &_starX[0], *yP = &_starY[0], *zP = &_starZ[0];
+	float *depthP = &_starDepth[0];
+	const float r1z = pose._row1._z, r2z = pose._row2._z, r3z = pose._row3._z;
+	const float vz = pose._vector._z;
+	for (uint idx = 0; idx < count; ++idx)
+		depthP[idx] = xP[idx] * r1z + yP[idx] * r2z + zP[idx] * r3z + vz;
+
+	// Only transform the rest of the stars that aren't behind the camera
+	uint visible = 0;
+	for (uint idx = 0; idx < count; ++idx) {
+		if (depthP[idx] <= minZ)
+			continue;
+
+		CStarTransform &star = _transformed[visible++];
+		star._index = idx;
+		star._z = depthP[idx];
+		star._y = xP[idx] * pose._row1._y + yP[idx] * pose._row2._y + zP[idx] * pose._row3._y + pose._vector._y;
+		star._x = xP[idx] * pose._row1._x + yP[idx] * pose._row2._x + zP[idx] * pose._row3._x + pose._vector._x;
+	}
+
+	return visible;
+}
+
 void CBaseStars::draw(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarCloseup *closeup) {
 	if (!_data.empty()) {
 		switch (camera->getStarColor()) {
@@ -174,16 +228,14 @@ void CBaseStars::draw1(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarClos
 	double *v1Ptr = &_value1, *v2Ptr = &_value2;
 	double tempX, tempY, tempZ, total2;
 
-	for (uint idx = 0; idx < _data.size(); ++idx) {
-		CBaseStarEntry &entry = _data[idx];
+	uint count = transformStars(pose, minVal);
+	for (uint starNum = 0; starNum < count; ++starNum) {
+		const CStarTransform &star = _transformed[starNum];
+		CBaseStarEntry &entry = _data[star._index];
 		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
-		if (tempZ <= minVal)
-			continue;
-
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
+		tempZ = star._z;
+		tempY = star._y;
+		tempX = star._x;
 		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ; 
 
 		if (total2 < 1.0e12) {
@@ -259,16 +311,14 @@ void CBaseStars::draw2(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarClos
 	double *v1Ptr = &_value1, *v2Ptr = &_value2;
 	double tempX, tempY, tempZ, total2;
 
-	for (uint idx = 0; idx < _data.size(); ++idx) {
-		CBaseStarEntry &entry = _data[idx];
+	uint count = transformStars(pose, minVal);
+	for (uint starNum = 0; starNum < count; ++starNum) {
+		const CStarTransform &star = _transformed[starNum];
+		CBaseStarEntry &entry = _data[star._index];
 		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
-		if (tempZ <= minVal)
-			continue;
-
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
+		tempZ = star._z;
+		tempY = star._y;
+		tempX = star._x;
 		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
 
 		if (total2 < 1.0e12) {
@@ -348,16 +398,14 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarClos
 	int xStart, yStart, rgb;
 	uint16 *pixelP;
 
-	for (uint idx = 0; idx < _data.size(); ++idx) {
-		CBaseStarEntry &entry = _data[idx];
+	uint count = transformStars(pose, minVal);
+	for (uint starNum = 0; starNum < count; ++starNum) {
+		const CStarTransform &star = _transformed[starNum];
+		CBaseStarEntry &entry = _data[star._index];
 		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
-		if (tempZ <= minVal)
-			continue;
-
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
+		tempZ = star._z;
+		tempY = star._y;
+		tempX = star._x;
 		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
 
 		if (total2 < 1.0e12) {
@@ -454,17 +502,14 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarClos
 	int xStart, yStart, rgb;
 	uint16 *pixelP;
 
-	for (uint idx = 0; idx < _data.size(); ++idx) {
-		const CBaseStarEntry &entry = _data[idx];
+	uint count = transformStars(pose, minVal);
+	for (uint starNum = 0; starNum < count; ++starNum) {
+		const CStarTransform &star = _transformed[starNum];
+		const CBaseStarEntry &entry = _data[star._index];
 		const FVector &vector = entry._position;
-
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
-		if (tempZ <= minVal)
-			continue;
-
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
+		tempZ = star._z;
+		tempY = star._y;
+		tempX = star._x;
 		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
 
 		if (total2 < 1.0e12) {
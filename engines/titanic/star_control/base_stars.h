@@ -36,6 +36,7 @@ enum StarMode { MODE_STARFIELD = 0, MODE_PHOTO = 1 };
 
 class CStarCamera;
 class CStarCloseup;
+class FPose;
 class CString;
 class CSurfaceArea;
 class SimpleFile;
@@ -69,11 +70,28 @@ struct CStarPosition : public Common::Point {
 	}
 };
 
+/**
+ * Camera space position of a star that passed the depth cull
+ */
+struct CStarTransform {
+	int _index;
+	float _x, _y, _z;
+};
+
 /**
  * Base class for views that draw a set of stars in simulated 3D space
  */
 class CBaseStars {
 private:
+	Common::Array<float> _starX, _starY, _starZ;
+	Common::Array<float> _starDepth;
+	bool _starBufferDirty;
+private:
+	/**
+	 * Rebuilds the separate position arrays used for batch transforms
+	 */
+	void updateStarBuffer();
+
 	void draw1(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarCloseup *closeup);
 	void draw2(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarCloseup *closeup);
 	void draw3(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarCloseup *closeup);
@@ -85,6 +103,7 @@ protected:
 	double _range;
 	double _value1, _value2;
 	double _value3, _value4;
+	Common::Array<CStarTransform> _transformed;
 protected:
 	/**
 	 * Load entry data from a passed stream
@@ -158,6 +177,24 @@ public:
 		const Common::Point &pt);
 
 	int baseFn2(CSurfaceArea *surfaceArea, CStarCamera *camera);
+
+	/**
+	 * Flags that the star data has been changed, so the position
+	 * arrays need rebuilding before the next transform
+	 */
+	void dataChanged() { _starBufferDirty = true; }
+
+	/**
+	 * Transforms all the stars into camera space, keeping those whose depth
+	 * isn't less than or equal to the passed minimum, in star order
+	 * @returns		Number of entries available through getTransformed
+	 */
+	uint transformStars(const FPose &pose, double minZ);
+
+	/**
+	 * Gets a star transformed by the last call to transformStars
+	 */
+	const CStarTransform &getTransformed(uint index) const { return _transformed[index]; }
 };
 
 class CStarVector {
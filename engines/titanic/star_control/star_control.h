@@ -108,6 +108,11 @@ public:
 	 * Updates the camerea for the star view
 	 */
 	void updateCamera() { _view.updateCamera(); }
+
+	/**
+	 * Times rendering the starfield from the current camera position
+	 */
+	uint32 timeRender(int frames) { return _view.timeRender(frames); }
 };
 
 } // End of namespace Titanic
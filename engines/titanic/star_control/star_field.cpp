@@ -21,14 +21,17 @@
  */
 
 #include "titanic/star_control/star_field.h"
+#include "titanic/debugger.h"
 #include "titanic/star_control/surface_area.h"
 #include "titanic/star_control/star_camera.h"
 #include "titanic/titanic.h"
+#include "common/system.h"
 
 namespace Titanic {
 
 CStarField::CStarField() : _points1On(false), _points2On(false), _mode(MODE_STARFIELD),
-		_showBox(true), _closeToMarker(false), _isSolved(false) {
+		_showBox(true), _closeToMarker(false), _isSolved(false),
+		_renderTime(0), _renderFrames(0) {
 }
 
 void CStarField::load(SimpleFile *file) {
@@ -64,6 +67,7 @@ bool CStarField::initDocument() {
 }
 
 void CStarField::render(CVideoSurface *surface, CStarCamera *camera) {
+	uint32 startTime = g_system->getMillis();
 	CSurfaceArea surfaceArea(surface);
 	draw(&surfaceArea, camera, &_starCloseup);
 	if (_showBox)
@@ -78,6 +82,15 @@ void CStarField::render(CVideoSurface *surface, CStarCamera *camera) {
 		_points1.draw(&surfaceArea, camera);
 
 	fn4(&surfaceArea, camera);
+
+	// Keep track of the average time taken to render the starfield
+	_renderTime += g_system->getMillis() - startTime;
+	if (++_renderFrames == 100) {
+		debugC(DEBUG_DETAILED, kDebugStarfield, "Starfield render %.2fms/frame for %d stars",
+			(double)_renderTime / _renderFrames, size());
+		_renderTime = 0;
+		_renderFrames = 0;
+	}
 }
 
 int CStarField::get1() const {
@@ -45,6 +45,8 @@ private:
 	bool _showBox;
 	bool _closeToMarker;
 	bool _isSolved;
+	uint32 _renderTime;
+	uint _renderFrames;
 private:
 	/**
 	 * Draws the big square box in the middle of the screen
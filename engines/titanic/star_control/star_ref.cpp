@@ -35,15 +35,19 @@ void CBaseStarRef::process(CSurfaceArea *surface, CStarCamera *camera) {
 	double threshold = camera->getThreshold();
 	double vWidth2 = (double)surface->_width * 0.5;
 	double vHeight2 = (double)surface->_height * 0.5;
-	FVector vTemp, vector1, vector2;
+	FVector vector1, vector2;
 	double val1, green, blue, red;
 
-	for (int idx = 0; idx < _stars->size(); ++idx) {
+	// Stars at or behind the threshold depth can never be hit, so only
+	// check the ones left after the stars' batch transform culls them
+	uint count = _stars->transformStars(pose, threshold);
+	for (uint starNum = 0; starNum < count; ++starNum) {
+		const CStarTransform &star = _stars->getTransformed(starNum);
+		int idx = star._index;
 		const CBaseStarEntry &se = _stars->_data[idx];
-		vTemp = se._position;
-		vector1._x = vTemp._x * pose._row1._x + vTemp._y * pose._row2._x + vTemp._z * pose._row3._x + pose._vector._x;
-		vector1._y = vTemp._x * pose._row1._y + vTemp._y * pose._row2._y + vTemp._z * pose._row3._y + pose._vector._y;
-		vector1._z = vTemp._x * pose._row1._z + vTemp._y * pose._row2._z + vTemp._z * pose._row3._z + pose._vector._z;
+		vector1._x = star._x;
+		vector1._y = star._y;
+		vector1._z = star._z;
 		double hyp = vector1._x * vector1._x + vector1._y * vector1._y + vector1._z * vector1._z;
 
 		if (vector1._z > threshold && hyp >= 1.0e12 && hyp < MAX_VAL) {
@@ -63,15 +67,15 @@ void CBaseStarRef::process(CSurfaceArea *surface, CStarCamera *camera) {
 				green = val1 * (double)se._green;
 				blue = val1 * (double)se._blue;
 
-				int count = 0;
+				int negCount = 0;
 				if (red < 0.0)
-					++count;
+					++negCount;
 				if (green < 0.0)
-					++count;
+					++negCount;
 				if (blue < 0.0)
-					++count;
+					++negCount;
 
-				if (count < 3) {
+				if (negCount < 3) {
 					if (!check(pt, idx))
 						break;
 				}
@@ -31,6 +31,7 @@
 #include "titanic/core/game_object.h"
 #include "titanic/messages/pet_messages.h"
 #include "titanic/pet_control/pet_control.h"
+#include "common/system.h"
 
 namespace Titanic {
 
@@ -120,6 +121,21 @@ void CStarView::draw(CScreenManager *screenManager) {
 	}
 }
 
+uint32 CStarView::timeRender(int frames) {
+	if (!_videoSurface || !_starField)
+		return 0;
+
+	uint32 startTime = g_system->getMillis();
+	for (int idx = 0; idx < frames; ++idx) {
+		_videoSurface->clear();
+		_videoSurface->lock();
+		_starField->render(_videoSurface, &_camera);
+		_videoSurface->unlock();
+	}
+
+	return g_system->getMillis() - startTime;
+}
+
 bool CStarView::MouseButtonDownMsg(int flags, const Point &pt) {
 	if (_starField) {
 		return _starField->mouseButtonDown(
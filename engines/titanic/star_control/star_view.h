@@ -95,6 +95,12 @@ public:
 	 */
 	void draw(CScreenManager *screenManager);
 
+	/**
+	 * Renders the starfield a given number of times from the current
+	 * camera position, and returns the time taken in milliseconds
+	 */
+	uint32 timeRender(int frames);
+
 	/**
 	 * Updates the camera, allowing for movement
 	 */
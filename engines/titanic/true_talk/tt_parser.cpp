@@ -34,6 +34,36 @@
 
 namespace Titanic {
 
+void TTreplacements::buildIndex() {
+	_wordIndex.clear();
+	_all.clear();
+	_indexed = true;
+
+	for (uint idx = 0; idx + 1 < _strings.size(); idx += 2) {
+		const CString &origStr = _strings[idx];
+		_all.push_back(idx);
+
+		// A match has to be followed by a space or the end of the line,
+		// so the line word at the match start equals the search string's first word
+		const char *spaceP = strchr(origStr.c_str(), ' ');
+		if (origStr.empty() || spaceP == origStr.c_str())
+			_indexed = false;
+		else if (!spaceP)
+			_wordIndex[origStr].push_back(idx);
+		else
+			_wordIndex[Common::String(origStr.c_str(), spaceP)].push_back(idx);
+	}
+}
+
+const Common::Array<uint> &TTreplacements::getCandidates(const Common::String &word) const {
+	if (!_indexed)
+		// Some search strings can't be indexed, so check them all
+		return _all;
+
+	Common::HashMap<Common::String, Common::Array<uint> >::const_iterator i = _wordIndex.find(word);
+	return (i == _wordIndex.end()) ? _none : i->_value;
+}
+
 TTparser::TTparser(CScriptHandler *owner) : _owner(owner), _sentenceConcept(nullptr),
 		_sentence(nullptr), _fieldC(0), _field10(0), _field14(0),
 		_currentWordP(nullptr), _nodesP(nullptr), _conceptP(nullptr) {
@@ -68,10 +98,15 @@ void TTparser::loadArray(StringArray &arr, const CString &name) {
 	delete r;
 }
 
+void TTparser::loadReplacements(TTreplacements &replacements, const CString &name) {
+	loadArray(replacements._strings, name);
+	replacements.buildIndex();
+}
+
 void TTparser::loadArrays() {
-	loadArray(_replacements1, "TEXT/REPLACEMENTS1");
-	loadArray(_replacements2, "TEXT/REPLACEMENTS2");
-	loadArray(_replacements3, "TEXT/REPLACEMENTS3");
+	loadReplacements(_replacements1, "TEXT/REPLACEMENTS1");
+	loadReplacements(_replacements2, "TEXT/REPLACEMENTS2");
+	loadReplacements(_replacements3, "TEXT/REPLACEMENTS3");
 	if (g_language == Common::DE_DEU)
 		loadArray(_replacements4, "TEXT/REPLACEMENTS4");
 	loadArray(_phrases, "TEXT/PHRASES");
@@ -363,18 +398,27 @@ bool TTparser::normalizeContraction(const TTstring &srcLine, int &srcIndex, TTst
 	return false;
 }
 
-void TTparser::searchAndReplace(TTstring &line, const StringArray &strings) {
+void TTparser::searchAndReplace(TTstring &line, const TTreplacements &replacements) {
 	int charIndex = 0;
 	while (charIndex >= 0)
-		charIndex = searchAndReplace(line, charIndex, strings);
+		charIndex = searchAndReplace(line, charIndex, replacements);
 }
 
-int TTparser::searchAndReplace(TTstring &line, int startIndex, const StringArray &strings) {
+int TTparser::searchAndReplace(TTstring &line, int startIndex, const TTreplacements &replacements) {
 	int lineSize = line.size();
 	if (startIndex >= lineSize)
 		return -1;
 
-	for (uint idx = 0; idx < strings.size(); idx += 2) {
+	// Only pairs whose search string starts with the current word can match
+	const char *wordP = line.c_str() + startIndex;
+	const char *wordEndP = strchr(wordP, ' ');
+	if (!wordEndP)
+		wordEndP = line.c_str() + lineSize;
+	const Common::Array<uint> &candidates = replacements.getCandidates(Common::String(wordP, wordEndP));
+	const StringArray &strings = replacements._strings;
+
+	for (uint candidateNum = 0; candidateNum < candidates.size(); ++candidateNum) {
+		uint idx = candidates[candidateNum];
 		const CString &origStr = strings[idx];
 		const CString &replacementStr = strings[idx + 1];
 
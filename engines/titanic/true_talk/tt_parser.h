@@ -27,6 +27,8 @@
 #include "titanic/true_talk/tt_pronoun.h"
 #include "titanic/true_talk/tt_sentence.h"
 #include "titanic/true_talk/tt_string.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 
 namespace Titanic {
 
@@ -64,11 +66,40 @@ public:
 	TTparserNode(uint tag) : TTnode(), _tag(tag) {}
 };
 
+/**
+ * List of search and replacement string pairs used when preprocessing
+ * sentences. Replacements only match at the start of a word, so the pairs
+ * are indexed by the first word of their search string to avoid testing
+ * every pair at every word of a line
+ */
+class TTreplacements {
+private:
+	Common::HashMap<Common::String, Common::Array<uint> > _wordIndex;
+	Common::Array<uint> _all;
+	Common::Array<uint> _none;
+	bool _indexed;
+public:
+	StringArray _strings;
+public:
+	TTreplacements() : _indexed(false) {}
+
+	/**
+	 * Builds the first word index once the string pairs have been loaded
+	 */
+	void buildIndex();
+
+	/**
+	 * Returns the indexes of pairs, in list order, whose search string
+	 * could match starting with the passed word
+	 */
+	const Common::Array<uint> &getCandidates(const Common::String &word) const;
+};
+
 class TTparser {
 private:
-	StringArray _replacements1;
-	StringArray _replacements2;
-	StringArray _replacements3;
+	TTreplacements _replacements1;
+	TTreplacements _replacements2;
+	TTreplacements _replacements3;
 	StringArray _replacements4;
 	StringArray _phrases;
 	NumberArray _numbers;
@@ -86,6 +117,11 @@ private:
 	 */
 	void loadArray(StringArray &arr, const CString &name);
 
+	/**
+	 * Loads a list of replacement string pairs and indexes them
+	 */
+	void loadReplacements(TTreplacements &replacements, const CString &name);
+
 	/**
 	 * Loads the various replacement string data arrays
 	 */
@@ -112,21 +148,21 @@ private:
 	 * Checks if any word within a passed line has an entry in the list of replacements,
 	 * and if found, replaces it with it's equivalent replacement string
 	 * @param line			Line to check
-	 * @param strings		List of strings to check for. Strings come in pairs, with the
-	 * first being the string to match, and the second the replacement
+	 * @param replacements	List of string pairs to check for, with the first of
+	 * each pair being the string to match, and the second the replacement
 	 */
-	static void searchAndReplace(TTstring &line, const StringArray &strings);
+	static void searchAndReplace(TTstring &line, const TTreplacements &replacements);
 
 	/**
 	 * Checks the string starting at a given index for any word in the passed string array,
 	 * and if found, replaces it in the line with it's replacement
 	 * @param line			Line to check
 	 * @param startIndex	Starting index in the start to check
-	 * @param strings		List of strings to check for. Strings come in pairs, with the
-	 * first being the string to match, and the second the replacement
+	 * @param replacements	List of string pairs to check for, with the first of
+	 * each pair being the string to match, and the second the replacement
 	 * @returns				Index of the start of the following word
 	 */
-	static int searchAndReplace(TTstring &line, int startIndex, const StringArray &strings);
+	static int searchAndReplace(TTstring &line, int startIndex, const TTreplacements &replacements);
 
 	/**
 	* Checks the string starting at a given index for a number representation
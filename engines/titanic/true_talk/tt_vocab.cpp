@@ -36,6 +36,7 @@ namespace Titanic {
 TTvocab::TTvocab(VocabMode vocabMode): _headP(nullptr), _tailP(nullptr),
 		_word(nullptr), _vocabMode(vocabMode) {
 	load("STVOCAB");
+	buildIndex();
 }
 
 TTvocab::~TTvocab() {
@@ -131,6 +132,24 @@ int TTvocab::load(const CString &name) {
 	return result;
 }
 
+void TTvocab::buildIndex() {
+	_index.clear();
+
+	for (TTword *word = _headP; word; word = word->_nextP) {
+		// Only the first word matching a given string is ever used
+		if (_vocabMode == VOCAB_MODE_EN && !_index.contains(word->c_str()))
+			_index[word->c_str()] = word;
+
+		for (TTstringNode *synP = word->_synP; synP;
+				synP = dynamic_cast<TTstringNode *>(synP->_nextP)) {
+			if (synP->_mode == _vocabMode || (_vocabMode == VOCAB_MODE_EN && synP->_mode < 3)) {
+				if (!_index.contains(synP->_string.c_str()))
+					_index[synP->_string.c_str()] = word;
+			}
+		}
+	}
+}
+
 void TTvocab::addWord(TTword *word) {
 	TTword *existingWord = g_language == Common::DE_DEU ? nullptr :
 		findWord(word->_text);
@@ -203,22 +222,22 @@ TTword *TTvocab::getPrimeWord(TTstring &str, TTword **srcWord) const {
 		vocabP = _headP;
 		newWord = new TTword(str, WC_ABSTRACT, 300);
 	} else {
-		// Standard word
-		for (vocabP = _headP; vocabP; vocabP = vocabP->_nextP) {
-			if (_vocabMode == VOCAB_MODE_EN && !strcmp(str.c_str(), vocabP->c_str())) {
-				newWord = vocabP->copy();
-				newWord->_nextP = nullptr;
-				newWord->setSyn(nullptr);
-				break;
-			} else if (vocabP->findSynByName(str, &tempSyn, _vocabMode)) {
-				// Create a copy of the word and the found synonym
-				TTsynonym *newSyn = new TTsynonym(tempSyn);
-				newSyn->_nextP = newSyn->_priorP = nullptr;
-				newWord = vocabP->copy();
-				newWord->_nextP = nullptr;
-				newWord->setSyn(newSyn);
-				break;
-			}
+		// Standard word. The index gives the first word in the vocab list
+		// whose text or one of whose synonyms matches
+		TTwordIndex::const_iterator i = _index.find(str.c_str());
+		vocabP = (i == _index.end()) ? nullptr : i->_value;
+
+		if (vocabP && _vocabMode == VOCAB_MODE_EN && !strcmp(str.c_str(), vocabP->c_str())) {
+			newWord = vocabP->copy();
+			newWord->_nextP = nullptr;
+			newWord->setSyn(nullptr);
+		} else if (vocabP && vocabP->findSynByName(str, &tempSyn, _vocabMode)) {
+			// Create a copy of the word and the found synonym
+			TTsynonym *newSyn = new TTsynonym(tempSyn);
+			newSyn->_nextP = newSyn->_priorP = nullptr;
+			newWord = vocabP->copy();
+			newWord->_nextP = nullptr;
+			newWord->setSyn(newSyn);
 		}
 	}
 
@@ -27,21 +27,33 @@
 #include "titanic/support/string.h"
 #include "titanic/true_talk/tt_string.h"
 #include "titanic/true_talk/tt_word.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 
 namespace Titanic {
 
+typedef Common::HashMap<Common::String, TTword *> TTwordIndex;
+
 class TTvocab {
 private:
 	TTword *_headP;
 	TTword *_tailP;
 	TTword *_word;
 	VocabMode _vocabMode;
+	TTwordIndex _index;
 private:
 	/**
 	 * Load the vocab data
 	 */
 	int load(const CString &name);
 
+	/**
+	 * Builds the lookup index of word text and synonyms. Each string maps to
+	 * the first word in the vocab list that getPrimeWord would match it
+	 * against, so lookups return the same word as a full scan of the list
+	 */
+	void buildIndex();
+
 	/**
 	 * Adds a specified word to the vocab list
 	 */
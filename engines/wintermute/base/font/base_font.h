@@ -45,6 +45,16 @@ public:
 
 	virtual void initLoop() {}
 	virtual void afterLoad() {}
+
+	struct CacheStats {
+		uint32 _glyphs;
+		uint32 _glyphHits;
+		uint32 _glyphMisses;
+		uint32 _textHits;
+		uint32 _textMisses;
+	};
+	/** Rendering cache counters, false if the font doesn't cache anything */
+	virtual bool getCacheStats(CacheStats &stats) const { return false; }
 	BaseFont(BaseGame *inGame);
 	virtual ~BaseFont();
 
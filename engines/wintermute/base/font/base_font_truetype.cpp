@@ -58,6 +58,8 @@ BaseFontTT::BaseFontTT(BaseGame *inGame) : BaseFont(inGame) {
 	for (int i = 0; i < NUM_CACHED_TEXTS; i++) {
 		_cachedTexts[i] = nullptr;
 	}
+	_textHits = _textMisses = 0;
+	_glyphHits = _glyphMisses = 0;
 
 	_lineHeight = 0;
 	_maxCharWidth = _maxCharHeight = 0;
@@ -88,6 +90,23 @@ void BaseFontTT::clearCache() {
 		}
 		_cachedTexts[i] = nullptr;
 	}
+	clearGlyphCache();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void BaseFontTT::clearGlyphCache() {
+	_glyphs.clear();
+	_glyphAtlas.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool BaseFontTT::getCacheStats(CacheStats &stats) const {
+	stats._glyphs = _glyphs.size();
+	stats._glyphHits = _glyphHits;
+	stats._glyphMisses = _glyphMisses;
+	stats._textHits = _textHits;
+	stats._textMisses = _textMisses;
+	return true;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -187,6 +206,7 @@ void BaseFontTT::drawText(const byte *text, int x, int y, int width, TTextAlign
 			if (_cachedTexts[i]->_text == textStr && _cachedTexts[i]->_align == align && _cachedTexts[i]->_width == width && _cachedTexts[i]->_maxHeight == maxHeight && _cachedTexts[i]->_maxLength == maxLength) {
 				surface = _cachedTexts[i]->_surface;
 				textOffset = _cachedTexts[i]->_textOffset;
+				_textHits++;
 				_cachedTexts[i]->_marked = true;
 				_cachedTexts[i]->_lastUsed = g_system->getMillis();
 				break;
@@ -201,6 +221,7 @@ void BaseFontTT::drawText(const byte *text, int x, int y, int width, TTextAlign
 
 	// not found, create one
 	if (!surface) {
+		_textMisses++;
 		debugC(kWintermuteDebugFont, "Draw text: %s", text);
 		surface = renderTextToTexture(textStr, width, align, maxHeight, textOffset);
 		if (surface) {
@@ -272,35 +293,22 @@ BaseSurface *BaseFontTT::renderTextToTexture(const WideString &text, int width,
 //	void drawString(Surface *dst, const Common::String &str, int x, int y, int w, uint32 color, TextAlign align = kTextAlignLeft, int deltax = 0, bool useEllipsis = true) const;
 	Graphics::Surface *surface = new Graphics::Surface();
 	surface->create((uint16)width, (uint16)(_lineHeight * lines.size()), _gameRef->_renderer->getPixelFormat());
-	uint32 useColor = 0xffffffff;
-	Common::Array<WideString>::iterator it;
-	int heightOffset = 0;
-	for (it = lines.begin(); it != lines.end(); ++it) {
-		_font->drawString(surface, *it, 0, heightOffset, width, useColor, alignment);
-		heightOffset += (int)_lineHeight;
-	}
-
-	BaseSurface *retSurface = _gameRef->_renderer->createSurface();
-
 	if (_deletableFont) {
-		// Reconstruct the alpha channel of the font.
-
-		// Since we painted it with color 0xFFFFFFFF onto a black background,
-		// the alpha channel is gone, but the color value of each pixel corresponds
-		// to its original alpha value.
-
-		Graphics::PixelFormat format = _gameRef->_renderer->getPixelFormat();
-		uint32 *pixels = (uint32 *)surface->getPixels();
-
-		// This is a Surface we created ourselves, so no empty space between rows.
-		for (int i = 0; i < surface->w * surface->h; ++i) {
-			uint8 a, r, g, b;
-			format.colorToRGB(*pixels, r, g, b);
-			a = r;
-			*pixels++ = format.ARGBToColor(a, r, g, b);
+		// TTF text is composed from the glyph cache, producing the alpha
+		// channel directly.
+		composeText(surface, lines, width, alignment);
+	} else {
+		uint32 useColor = 0xffffffff;
+		Common::Array<WideString>::iterator it;
+		int heightOffset = 0;
+		for (it = lines.begin(); it != lines.end(); ++it) {
+			_font->drawString(surface, *it, 0, heightOffset, width, useColor, alignment);
+			heightOffset += (int)_lineHeight;
 		}
 	}
 
+	BaseSurface *retSurface = _gameRef->_renderer->createSurface();
+
 	retSurface->putSurface(*surface, true);
 	surface->free();
 	delete surface;
@@ -309,6 +317,144 @@ BaseSurface *BaseFontTT::renderTextToTexture(const WideString &text, int width,
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+const BaseFontTT::CachedGlyph &BaseFontTT::getGlyph(uint32 chr) {
+	GlyphCache::iterator entry = _glyphs.find(chr);
+	if (entry != _glyphs.end()) {
+		_glyphHits++;
+		return entry->_value;
+	}
+	_glyphMisses++;
+
+	// Fonts with huge character sets shouldn't grow the atlas forever
+	if (_glyphAtlas.size() > 1024 * 1024) {
+		clearGlyphCache();
+	}
+
+	CachedGlyph &glyph = _glyphs[chr];
+	glyph._box = _font->getBoundingBox(chr);
+	glyph._offset = _glyphAtlas.size();
+
+	const int w = glyph._box.width();
+	const int h = glyph._box.height();
+	if (w <= 0 || h <= 0) {
+		glyph._box = Common::Rect();
+		return glyph;
+	}
+
+	// Draw the glyph in white onto black, which leaves its coverage in
+	// every color channel.
+	Graphics::Surface image;
+	image.create((uint16)w, (uint16)h, _gameRef->_renderer->getPixelFormat());
+	_font->drawChar(&image, chr, -glyph._box.left, -glyph._box.top, 0xffffffff);
+
+	_glyphAtlas.resize(glyph._offset + w * h);
+	byte *dst = &_glyphAtlas[glyph._offset];
+	for (int y = 0; y < h; y++) {
+		const uint32 *src = (const uint32 *)image.getBasePtr(0, y);
+		for (int x = 0; x < w; x++) {
+			uint8 r, g, b;
+			image.format.colorToRGB(*src++, r, g, b);
+			*dst++ = r;
+		}
+	}
+	image.free();
+
+	return glyph;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void BaseFontTT::composeText(Graphics::Surface *surface, const Common::Array<WideString> &lines, int width, Graphics::TextAlign alignment) {
+	const int surfaceW = surface->w;
+	const int surfaceH = surface->h;
+	if (surfaceW <= 0 || surfaceH <= 0) {
+		return;
+	}
+
+	_textCoverage.resize(surfaceW * surfaceH);
+	memset(&_textCoverage[0], 0, surfaceW * surfaceH);
+
+	int heightOffset = 0;
+	for (uint32 line = 0; line < lines.size(); line++) {
+		const WideString &str = lines[line];
+
+		// Lay the line out exactly like Font::drawString() does
+		int x = 0;
+		if (alignment == Graphics::kTextAlignCenter) {
+			x = (width - _font->getStringWidth(str)) / 2;
+		} else if (alignment == Graphics::kTextAlignRight) {
+			x = width - _font->getStringWidth(str);
+		}
+
+		uint32 last = 0;
+		for (uint32 i = 0; i < str.size(); i++) {
+			const uint32 cur = str[i];
+			x += _font->getKerningOffset(last, cur);
+			last = cur;
+
+			const CachedGlyph &glyph = getGlyph(cur);
+			if (x + glyph._box.right > width) {
+				break;
+			}
+
+			// Clip the glyph to the surface
+			int dstX = x + glyph._box.left;
+			int dstY = heightOffset + glyph._box.top;
+			int srcX = 0, srcY = 0;
+			int w = glyph._box.width();
+			int h = glyph._box.height();
+			if (dstX < 0) {
+				srcX = -dstX;
+				w += dstX;
+				dstX = 0;
+			}
+			if (dstY < 0) {
+				srcY = -dstY;
+				h += dstY;
+				dstY = 0;
+			}
+			w = MIN(w, surfaceW - dstX);
+			h = MIN(h, surfaceH - dstY);
+
+			if (x + glyph._box.right >= 0 && w > 0 && h > 0) {
+				const int srcPitch = glyph._box.width();
+				const byte *src = &_glyphAtlas[glyph._offset + srcY * srcPitch + srcX];
+				byte *dst = &_textCoverage[dstY * surfaceW + dstX];
+				for (int cy = 0; cy < h; cy++) {
+					for (int cx = 0; cx < w; cx++) {
+						// Same blending as drawing white glyphs onto the surface
+						const uint a = src[cx];
+						if (a == 255) {
+							dst[cx] = 255;
+						} else if (a) {
+							dst[cx] = (byte)(((255 - a) * dst[cx] + a * 255) / 255);
+						}
+					}
+					src += srcPitch;
+					dst += surfaceW;
+				}
+			}
+
+			x += _font->getCharWidth(cur);
+		}
+		heightOffset += (int)_lineHeight;
+	}
+
+	// Coverage becomes both the alpha and the color of each pixel
+	uint32 palette[256];
+	for (int i = 0; i < 256; i++) {
+		palette[i] = surface->format.ARGBToColor(i, i, i, i);
+	}
+
+	const byte *src = &_textCoverage[0];
+	for (int y = 0; y < surfaceH; y++) {
+		uint32 *dst = (uint32 *)surface->getBasePtr(0, y);
+		for (int x = 0; x < surfaceW; x++) {
+			*dst++ = palette[*src++];
+		}
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 int BaseFontTT::getLetterHeight() {
 	return (int)getLineHeight();
@@ -562,6 +708,7 @@ bool BaseFontTT::initFont() {
 	if (!_fontFile) {
 		return STATUS_FAILED;
 	}
+	clearGlyphCache();
 #ifdef USE_FREETYPE2
 	Common::String fallbackFilename;
 	// Handle Bold atleast for the fallback-case.
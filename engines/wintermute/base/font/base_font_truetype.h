@@ -33,6 +33,7 @@
 #include "engines/wintermute/base/font/base_font.h"
 #include "engines/wintermute/base/gfx/base_surface.h"
 #include "common/rect.h"
+#include "common/hashmap.h"
 #include "graphics/surface.h"
 #include "graphics/font.h"
 
@@ -113,6 +114,7 @@ public:
 
 	void afterLoad();
 	void initLoop();
+	virtual bool getCacheStats(CacheStats &stats) const override;
 
 private:
 	bool parseLayer(BaseTTFontLayer *layer, char *buffer);
@@ -122,6 +124,28 @@ private:
 	BaseSurface *renderTextToTexture(const WideString &text, int width, TTextAlign align, int maxHeight, int &textOffset);
 
 	BaseCachedTTFontText *_cachedTexts[NUM_CACHED_TEXTS];
+	uint32 _textHits;
+	uint32 _textMisses;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Rasterized TTF glyphs, stored as 8-bit coverage in one shared atlas
+	// buffer. New strings are composed from these instead of being drawn
+	// through the font and converted pixel by pixel.
+	struct CachedGlyph {
+		Common::Rect _box; // relative to the pen position, see Font::getBoundingBox()
+		uint32 _offset;    // of the first coverage row in _glyphAtlas
+	};
+	typedef Common::HashMap<uint32, CachedGlyph> GlyphCache;
+
+	const CachedGlyph &getGlyph(uint32 chr);
+	void composeText(Graphics::Surface *surface, const Common::Array<WideString> &lines, int width, Graphics::TextAlign alignment);
+	void clearGlyphCache();
+
+	GlyphCache _glyphs;
+	Common::Array<byte> _glyphAtlas;
+	Common::Array<byte> _textCoverage;
+	uint32 _glyphHits;
+	uint32 _glyphMisses;
 
 	bool initFont();
 
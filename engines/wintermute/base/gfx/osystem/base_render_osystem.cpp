@@ -38,8 +38,10 @@
 #include "graphics/transparent_surface.h"
 #include "common/queue.h"
 #include "common/config-manager.h"
+#include "engines/wintermute/wintermute.h"
 
 #define DIRTY_RECT_LIMIT 800
+#define MAX_DIRTY_REGIONS 16
 
 namespace Wintermute {
 
@@ -57,7 +59,6 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -75,8 +76,6 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		delete ticket;
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 	_blankSurface->free();
@@ -154,8 +153,7 @@ bool BaseRenderOSystem::indicatorFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -194,9 +192,7 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
@@ -364,13 +360,52 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 	}
 }
 
+static inline uint32 rectArea(const Common::Rect &rect) {
+	return (uint32)rect.width() * (uint32)rect.height();
+}
+
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	Common::Rect dirty(rect);
+	dirty.clip(_renderRect);
+	if (dirty.isEmpty()) {
+		return;
+	}
+
+	for (;;) {
+		// Swallow the regions the new one overlaps, so that no pixel gets
+		// redrawn twice. The grown rect may overlap more, so start over.
+		uint i;
+		for (i = 0; i < _dirtyRects.size(); i++) {
+			if (_dirtyRects[i].intersects(dirty)) {
+				break;
+			}
+		}
+
+		if (i == _dirtyRects.size()) {
+			if (_dirtyRects.size() < MAX_DIRTY_REGIONS) {
+				break;
+			}
+
+			// Too fragmented, merge with the region that adds the fewest
+			// clean pixels to the redraw.
+			uint32 bestWaste = 0xFFFFFFFF;
+			for (uint j = 0; j < _dirtyRects.size(); j++) {
+				Common::Rect merged(dirty);
+				merged.extend(_dirtyRects[j]);
+				uint32 waste = rectArea(merged) - rectArea(dirty) - rectArea(_dirtyRects[j]);
+				if (waste < bestWaste || bestWaste == 0xFFFFFFFF) {
+					bestWaste = waste;
+					i = j;
+				}
+			}
+		}
+
+		dirty.extend(_dirtyRects[i]);
+		_dirtyRects[i] = _dirtyRects.back();
+		_dirtyRects.pop_back();
 	}
-	_dirtyRect->clip(_renderRect);
+
+	_dirtyRects.push_back(dirty);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -389,7 +424,7 @@ void BaseRenderOSystem::drawTickets() {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	if (_dirtyRects.empty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
@@ -399,43 +434,69 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
+	uint32 pixelsRedrawn = 0;
+	Common::Rect dirtyBounds(_dirtyRects[0]);
+	for (uint i = 1; i < _dirtyRects.size(); i++) {
+		dirtyBounds.extend(_dirtyRects[i]);
+	}
+
 	it = _renderQueue.begin();
 	_lastFrameIter = _renderQueue.end();
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
 	// the background color. Typical use-case: Fullscreen FMVs.
 	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
-		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
+	bool singleOpaque = (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true);
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		// If our single opaque rect covers the dirty rect, we can skip filling.
+		if (!singleOpaque || !(*it)->_dstRect.contains(_dirtyRects[i])) {
 			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+			_renderSurface->fillRect(_dirtyRects[i], _clearColor);
 		}
-		// Otherwise Do NOT fill.
-	} else {
-		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		pixelsRedrawn += rectArea(_dirtyRects[i]);
 	}
+
+	// The regions are disjoint, so the tickets can be walked once in queue
+	// order, drawing each one into every region it touches.
+	uint32 ticketsVisited = 0;
+	uint32 ticketsDrawn = 0;
 	for (; it != _renderQueue.end(); ++it) {
 		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
-			// dstClip is the area we want redrawn.
-			Common::Rect dstClip(ticket->_dstRect);
-			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
-			// we need to keep track of the position to redraw the dirty rect
-			Common::Rect pos(dstClip);
-			int16 offsetX = ticket->_dstRect.left;
-			int16 offsetY = ticket->_dstRect.top;
-			// convert from screen-coords to surface-coords.
-			dstClip.translate(-offsetX, -offsetY);
-
-			drawFromSurface(ticket, &pos, &dstClip);
-			_needsFlip = true;
+		ticketsVisited++;
+		if (ticket->_dstRect.intersects(dirtyBounds)) {
+			bool drawn = false;
+			for (uint i = 0; i < _dirtyRects.size(); i++) {
+				if (!ticket->_dstRect.intersects(_dirtyRects[i])) {
+					continue;
+				}
+				// dstClip is the area we want redrawn.
+				Common::Rect dstClip(ticket->_dstRect);
+				// reduce it to the dirty rect
+				dstClip.clip(_dirtyRects[i]);
+				// we need to keep track of the position to redraw the dirty rect
+				Common::Rect pos(dstClip);
+				int16 offsetX = ticket->_dstRect.left;
+				int16 offsetY = ticket->_dstRect.top;
+				// convert from screen-coords to surface-coords.
+				dstClip.translate(-offsetX, -offsetY);
+
+				drawFromSurface(ticket, &pos, &dstClip);
+				drawn = true;
+			}
+			if (drawn) {
+				ticketsDrawn++;
+				_needsFlip = true;
+			}
 		}
 		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
 		ticket->_wantsDraw = false;
 	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		const Common::Rect &dirty = _dirtyRects[i];
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(dirty.left, dirty.top), _renderSurface->pitch, dirty.left, dirty.top, dirty.width(), dirty.height());
+	}
+
+	debugC(kWintermuteDebugRender, "drawTickets: %u dirty regions, %u pixels redrawn, %u of %u visited tickets drawn",
+	       _dirtyRects.size(), pixelsRedrawn, ticketsDrawn, ticketsVisited);
 
 	it = _renderQueue.begin();
 	// Clean out the old tickets
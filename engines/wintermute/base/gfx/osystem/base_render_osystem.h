@@ -33,6 +33,7 @@
 #include "common/rect.h"
 #include "graphics/surface.h"
 #include "common/list.h"
+#include "common/array.h"
 #include "graphics/transform_struct.h"
 
 namespace Wintermute {
@@ -115,6 +116,9 @@ public:
 private:
 	/**
 	 * Mark a specified rect of the screen as dirty.
+	 * The dirty regions are kept disjoint: the new rect swallows every region
+	 * it overlaps, and once there are too many regions the two cheapest to
+	 * combine are merged.
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
@@ -126,7 +130,7 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	Common::Array<Common::Rect> _dirtyRects;
 	Common::List<RenderTicket *> _renderQueue;
 
 	bool _needsFlip;
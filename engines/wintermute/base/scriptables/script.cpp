@@ -49,6 +49,8 @@ ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 
 	_symbols = nullptr;
 	_numSymbols = 0;
+	_varBindings = nullptr;
+	_instructionCount = 0;
 
 	_engine = engine;
 
@@ -176,6 +178,10 @@ bool ScScript::initTables() {
 		_symbols[index] = getString();
 	}
 
+	delete[] _varBindings;
+	_varBindings = new TVarBinding[_numSymbols];
+	memset(_varBindings, 0, _numSymbols * sizeof(TVarBinding));
+
 	// load functions table
 	_iP = _header.funcTable;
 
@@ -398,6 +404,9 @@ void ScScript::cleanup() {
 	_symbols = nullptr;
 	_numSymbols = 0;
 
+	delete[] _varBindings;
+	_varBindings = nullptr;
+
 	if (_globals && !_thread) {
 		delete _globals;
 	}
@@ -524,6 +533,7 @@ bool ScScript::executeInstruction() {
 	ScValue *op2;
 
 	uint32 inst = getDWORD();
+	_instructionCount++;
 
 	preInstHook(inst);
 
@@ -697,7 +707,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getSymbolVar(getDWORD());
 		if (false && /*var->_type==VAL_OBJECT ||*/ var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
 			_stack->push(_operand);
@@ -708,15 +718,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getSymbolVar(getDWORD());
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		ScValue *var = getSymbolVar(getDWORD());
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -769,7 +778,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getSymbolVar(getDWORD()));
 		_thisStack->push(_operand);
 		break;
 
@@ -1170,6 +1179,51 @@ ScValue *ScScript::getVar(char *name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+static inline bool isPlainPropSet(ScValue *value) {
+	// natives, references and strings may answer property queries
+	// without looking at their own property map
+	return value->_type != VAL_NATIVE && value->_type != VAL_VARIABLE_REF && value->_type != VAL_STRING;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getSymbolVar(uint32 symbol) {
+	if (!_varBindings || symbol >= _numSymbols) {
+		return getVar(_symbols[symbol]);
+	}
+
+	ScValue *scope = _scopeStack->getTop();
+	ScValue *engineGlobals = _engine->_globals;
+	TVarBinding &binding = _varBindings[symbol];
+
+	if (binding.var && binding.scope == scope && binding.globals == _globals && binding.engineGlobals == engineGlobals &&
+	        (!scope || (isPlainPropSet(scope) && scope->getPropsVersion() == binding.scopeVersion)) &&
+	        isPlainPropSet(_globals) && _globals->getPropsVersion() == binding.globalsVersion &&
+	        isPlainPropSet(engineGlobals) && engineGlobals->getPropsVersion() == binding.engineGlobalsVersion) {
+		return binding.var;
+	}
+
+	ScValue *ret = getVar(_symbols[symbol]);
+
+	// getVar() may have had to create the variable, so take the stamps
+	// afterwards
+	if (ret && (!scope || isPlainPropSet(scope)) && isPlainPropSet(_globals) && isPlainPropSet(engineGlobals)) {
+		binding.scope = scope;
+		binding.globals = _globals;
+		binding.engineGlobals = engineGlobals;
+		binding.scopeVersion = scope ? scope->getPropsVersion() : 0;
+		binding.globalsVersion = _globals->getPropsVersion();
+		binding.engineGlobalsVersion = engineGlobals->getPropsVersion();
+		binding.var = ret;
+	} else {
+		binding.var = nullptr;
+	}
+
+	return ret;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::waitFor(BaseObject *object) {
 	if (_unbreakable) {
@@ -80,6 +80,7 @@ public:
 	TScriptState _state;
 	TScriptState _origState;
 	ScValue *getVar(char *name);
+	ScValue *getSymbolVar(uint32 symbol);
 	uint32 getFuncPos(const Common::String &name);
 	uint32 getEventPos(const Common::String &name) const;
 	uint32 getMethodPos(const Common::String &name) const;
@@ -147,12 +148,26 @@ public:
 	bool _thread;
 	bool _methodThread;
 	char *_threadEvent;
+	uint32 _instructionCount;
 	BaseScriptHolder *_owner;
 	ScScript::TExternalFunction *getExternal(char *name);
 	bool externalCall(ScStack *stack, ScStack *thisStack, ScScript::TExternalFunction *function);
 private:
+	// Where getVar() last found a symbol, valid as long as none of the
+	// variable sets it searched has gained or lost a property since
+	typedef struct {
+		ScValue *scope;
+		ScValue *globals;
+		ScValue *engineGlobals;
+		uint32 scopeVersion;
+		uint32 globalsVersion;
+		uint32 engineGlobalsVersion;
+		ScValue *var;
+	} TVarBinding;
+
 	char **_symbols;
 	uint32 _numSymbols;
+	TVarBinding *_varBindings;
 	TFunctionPos *_functions;
 	TMethodPos *_methods;
 	TEventPos *_events;
@@ -34,6 +34,7 @@
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/utils/utils.h"
+#include "common/algorithm.h"
 
 namespace Wintermute {
 
@@ -338,6 +339,8 @@ bool ScEngine::tick() {
 			continue;
 		}
 
+		uint32 startInstructions = _scripts[i]->_instructionCount;
+
 		// time sliced script
 		if (_scripts[i]->_timeSlice > 0) {
 			uint32 startTime = g_system->getMillis();
@@ -346,7 +349,7 @@ bool ScEngine::tick() {
 				_scripts[i]->executeInstruction();
 			}
 			if (_isProfiling && _scripts[i]->_filename) {
-				addScriptTime(_scripts[i]->_filename, g_system->getMillis() - startTime);
+				addScriptTime(_scripts[i], g_system->getMillis() - startTime, _scripts[i]->_instructionCount - startInstructions);
 			}
 		}
 
@@ -363,7 +366,7 @@ bool ScEngine::tick() {
 				_scripts[i]->executeInstruction();
 			}
 			if (isProfiling && _scripts[i]->_filename) {
-				addScriptTime(_scripts[i]->_filename, g_system->getMillis() - startTime);
+				addScriptTime(_scripts[i], g_system->getMillis() - startTime, _scripts[i]->_instructionCount - startInstructions);
 			}
 		}
 		_currentScript = nullptr;
@@ -572,14 +575,45 @@ bool ScEngine::clearGlobals(bool includingNatives) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-void ScEngine::addScriptTime(const char *filename, uint32 time) {
+void ScEngine::addScriptTime(ScScript *script, uint32 time, uint32 instructions) {
 	if (!_isProfiling) {
 		return;
 	}
 
-	AnsiString fileName = filename;
-	fileName.toLowercase();
-	_scriptTimes[fileName] += time;
+	// Event handlers and methods are run by threads of their script,
+	// account for them separately
+	AnsiString name = script->_filename;
+	name.toLowercase();
+	if (script->_thread && script->_threadEvent) {
+		name += (script->_methodThread ? "." : ":");
+		name += script->_threadEvent;
+	}
+
+	ScriptProfile &profile = _scriptTimes[name];
+	profile._time += time;
+	profile._instructions += instructions;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+static bool compareScriptProfiles(const ScEngine::ScriptProfile &a, const ScEngine::ScriptProfile &b) {
+	if (a._instructions != b._instructions) {
+		return a._instructions > b._instructions;
+	}
+	return a._time > b._time;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::getProfile(Common::Array<ScriptProfile> &profile, uint32 &totalTime) {
+	profile.clear();
+	totalTime = _isProfiling ? g_system->getMillis() - _profilingStartTime : 0;
+
+	for (ScriptTimes::iterator it = _scriptTimes.begin(); it != _scriptTimes.end(); ++it) {
+		profile.push_back(it->_value);
+		profile.back()._name = it->_key;
+	}
+	Common::sort(profile.begin(), profile.end(), compareScriptProfiles);
 }
 
 
@@ -610,27 +644,17 @@ void ScEngine::disableProfiling() {
 
 //////////////////////////////////////////////////////////////////////////
 void ScEngine::dumpStats() {
-	error("DumpStats not ported to ScummVM yet");
-	/*  uint32 totalTime = g_system->getMillis() - _profilingStartTime;
-
-	    typedef std::vector <std::pair<uint32, std::string> > TimeVector;
-	    TimeVector times;
+	Common::Array<ScriptProfile> profile;
+	uint32 totalTime;
+	getProfile(profile, totalTime);
 
-	    ScriptTimes::iterator it;
-	    for (it = _scriptTimes.begin(); it != _scriptTimes.end(); ++it) {
-	        times.push_back(std::pair<uint32, std::string> (it->_value, it->_key));
-	    }
-	    std::sort(times.begin(), times.end());
+	_gameRef->LOG(0, "***** Script profiling information: *****");
+	_gameRef->LOG(0, "  %-40s %fs", "Total execution time", (float)totalTime / 1000);
 
-
-	    TimeVector::reverse_iterator tit;
-
-	    _gameRef->LOG(0, "***** Script profiling information: *****");
-	    _gameRef->LOG(0, "  %-40s %fs", "Total execution time", (float)totalTime / 1000);
-
-	    for (tit = times.rbegin(); tit != times.rend(); ++tit) {
-	        _gameRef->LOG(0, "  %-40s %fs (%f%%)", tit->second.c_str(), (float)tit->first / 1000, (float)tit->first / (float)totalTime * 100);
-	    }*/
+	for (uint32 i = 0; i < profile.size(); i++) {
+		_gameRef->LOG(0, "  %-40s %fs (%f%%), %u instructions", profile[i]._name.c_str(), (float)profile[i]._time / 1000,
+		              totalTime ? (float)profile[i]._time / (float)totalTime * 100 : 0.0f, profile[i]._instructions);
+	}
 }
 
 } // End of namespace Wintermute
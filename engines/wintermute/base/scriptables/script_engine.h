@@ -102,8 +102,18 @@ public:
 		return _isProfiling;
 	}
 
-	void addScriptTime(const char *filename, uint32 Time);
+	struct ScriptProfile {
+		Common::String _name;
+		uint32 _time;
+		uint32 _instructions;
+
+		ScriptProfile() : _time(0), _instructions(0) {}
+	};
+
+	void addScriptTime(ScScript *script, uint32 time, uint32 instructions);
 	void dumpStats();
+	/** Profiled scripts and methods, the busiest ones first */
+	void getProfile(Common::Array<ScriptProfile> &profile, uint32 &totalTime);
 
 private:
 
@@ -111,7 +121,7 @@ private:
 	bool _isProfiling;
 	uint32 _profilingStartTime;
 
-	typedef Common::HashMap<Common::String, uint32> ScriptTimes;
+	typedef Common::HashMap<Common::String, ScriptProfile> ScriptTimes;
 	ScriptTimes _scriptTimes;
 
 };
@@ -83,6 +83,13 @@ public:
 	bool isObject();
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
 	ScValue *getProp(const char *name);
+
+	/**
+	 * Stamp that changes whenever a property is added to or removed from
+	 * this value. Stamps are never reused, not even by other values, so
+	 * a (value, stamp) pair identifies one exact set of properties.
+	 */
+	uint32 getPropsVersion() const { return _propsVersion; }
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
 private:
@@ -90,6 +97,10 @@ private:
 	int32 _valInt;
 	double _valFloat;
 	char *_valString;
+	uint32 _propsVersion;
+	static uint32 _lastPropsVersion;
+
+	void touchProps() { _propsVersion = ++_lastPropsVersion; }
 public:
 	TValType _type;
 	ScValue(BaseGame *inGame);
@@ -23,6 +23,10 @@
 #include "engines/wintermute/debugger.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
+#include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/font/base_font_storage.h"
+#include "engines/wintermute/base/font/base_font.h"
+#include "engines/wintermute/base/scriptables/script_engine.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/debugger/debugger_controller.h"
 #include "engines/wintermute/wintermute.h"
@@ -36,6 +40,8 @@ Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	registerCmd("script_stats", WRAP_METHOD(Console, Cmd_ScriptStats));
+	registerCmd("font_cache_stats", WRAP_METHOD(Console, Cmd_FontCacheStats));
 	registerCmd("help", WRAP_METHOD(Console, Cmd_Help));
 	// Actual (script) debugger commands
 	registerCmd(STEP_CMD, WRAP_METHOD(Console, Cmd_Step));
@@ -308,6 +314,61 @@ bool Console::Cmd_ShowFps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_ScriptStats(int argc, const char **argv) {
+	ScEngine *scEngine = _engineRef->_game ? _engineRef->_game->_scEngine : nullptr;
+	if (!scEngine) {
+		debugPrintf("No game is running\n");
+		return true;
+	}
+
+	if (argc == 2 && Common::String(argv[1]) == "on") {
+		scEngine->enableProfiling();
+		debugPrintf("Script profiling enabled\n");
+	} else if (argc == 2 && Common::String(argv[1]) == "off") {
+		// The final statistics go to the game log
+		scEngine->disableProfiling();
+		debugPrintf("Script profiling disabled\n");
+	} else if (argc == 1 || (argc == 3 && Common::String(argv[1]) == "top")) {
+		if (!scEngine->getIsProfiling()) {
+			debugPrintf("Script profiling is off, use \"%s on\" to start it\n", argv[0]);
+			return true;
+		}
+
+		Common::Array<ScEngine::ScriptProfile> profile;
+		uint32 totalTime;
+		scEngine->getProfile(profile, totalTime);
+
+		uint32 count = (argc == 3) ? atoi(argv[2]) : 20;
+		debugPrintf("%u ms profiled\n", totalTime);
+		debugPrintf("%12s %8s  %s\n", "instructions", "ms", "script");
+		for (uint32 i = 0; i < profile.size() && i < count; i++) {
+			debugPrintf("%12u %8u  %s\n", profile[i]._instructions, profile[i]._time, profile[i]._name.c_str());
+		}
+	} else {
+		debugPrintf("Usage: %s [on|off|top <count>]\n", argv[0]);
+	}
+	return true;
+}
+
+bool Console::Cmd_FontCacheStats(int argc, const char **argv) {
+	BaseFontStorage *fontStorage = _engineRef->_game ? _engineRef->_game->_fontStorage : nullptr;
+	if (!fontStorage) {
+		debugPrintf("No game is running\n");
+		return true;
+	}
+
+	debugPrintf("%6s %10s %10s %10s %10s  %s\n", "glyphs", "glyph hit", "glyph miss", "text hit", "text miss", "font");
+	for (uint32 i = 0; i < fontStorage->_fonts.size(); i++) {
+		BaseFont *font = fontStorage->_fonts[i];
+		BaseFont::CacheStats stats;
+		if (font && font->getCacheStats(stats)) {
+			debugPrintf("%6u %10u %10u %10u %10u  %s\n", stats._glyphs, stats._glyphHits, stats._glyphMisses,
+			            stats._textHits, stats._textMisses, font->getFilename() ? font->getFilename() : "");
+		}
+	}
+	return true;
+}
+
 bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	if (argc != 3) {
 		debugPrintf("Usage: %s <file path> <output file name>\n", argv[0]);
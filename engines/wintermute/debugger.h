@@ -70,6 +70,8 @@ public:
 	bool Cmd_Help(int argc, const char **argv);
 	bool Cmd_ShowFps(int argc, const char **argv);
 	bool Cmd_DumpFile(int argc, const char **argv);
+	bool Cmd_ScriptStats(int argc, const char **argv);
+	bool Cmd_FontCacheStats(int argc, const char **argv);
 
 #if EXTENDED_DEBUGGER_ENABLED
 	/**
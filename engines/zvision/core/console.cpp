@@ -48,6 +48,7 @@ Console::Console(ZVision *engine) : GUI::Debugger(), _engine(engine) {
 	registerCmd("raw2wav", WRAP_METHOD(Console, cmdRawToWav));
 	registerCmd("setrenderstate", WRAP_METHOD(Console, cmdSetRenderState));
 	registerCmd("generaterendertable", WRAP_METHOD(Console, cmdGenerateRenderTable));
+	registerCmd("rendertable_bench", WRAP_METHOD(Console, cmdRenderTableBench));
 	registerCmd("setpanoramafov", WRAP_METHOD(Console, cmdSetPanoramaFoV));
 	registerCmd("setpanoramascale", WRAP_METHOD(Console, cmdSetPanoramaScale));
 	registerCmd("location", WRAP_METHOD(Console, cmdLocation));
@@ -179,6 +180,74 @@ bool Console::cmdGenerateRenderTable(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdRenderTableBench(int argc, const char **argv) {
+	if (argc != 1 && argc != 3) {
+		debugPrintf("Use %s [<width> <height>] to time warping a panorama and tilt view of the given size\n", argv[0]);
+		return true;
+	}
+
+	int width = 640;
+	int height = 480;
+	if (argc == 3) {
+		width = atoi(argv[1]);
+		height = atoi(argv[2]);
+	}
+	if (width <= 0 || height <= 0) {
+		debugPrintf("Invalid size\n");
+		return true;
+	}
+
+	const int frameCount = 20;
+	const Graphics::PixelFormat format(2, 5, 5, 5, 0, 10, 5, 0, 0);
+
+	Graphics::Surface source;
+	Graphics::Surface dest;
+	source.create(width, height, format);
+	dest.create(width, height, format);
+
+	// Something that isn't uniform, so that filtering has to blend
+	uint16 *pixels = (uint16 *)source.getPixels();
+	for (int i = 0; i < width * height; ++i) {
+		pixels[i] = (uint16)(i * 2654435761U >> 16) & 0x7FFF;
+	}
+
+	RenderTable renderTable(width, height);
+	for (int state = 0; state < 2; ++state) {
+		renderTable.setRenderState(state == 0 ? RenderTable::PANORAMA : RenderTable::TILT);
+
+		// Sweep the fields of view the scripts use, since they change the table
+		for (int fov = 20; fov <= 60; fov += 10) {
+			if (state == 0) {
+				renderTable.setPanoramaFoV(fov);
+			} else {
+				renderTable.setTiltFoV(fov);
+			}
+
+			uint32 startTime = _engine->_system->getMillis();
+			renderTable.generateRenderTable();
+			uint32 generateTime = _engine->_system->getMillis() - startTime;
+
+			uint32 time[2];
+			for (int highQuality = 0; highQuality < 2; ++highQuality) {
+				renderTable.setHighQuality(highQuality != 0);
+				startTime = _engine->_system->getMillis();
+				for (int frame = 0; frame < frameCount; ++frame) {
+					renderTable.mutateImage(&dest, &source);
+				}
+				time[highQuality] = _engine->_system->getMillis() - startTime;
+			}
+
+			debugPrintf("%s %dx%d fov %d: table %u ms, nearest %.2f ms, filtered %.2f ms per frame\n",
+				state == 0 ? "panorama" : "tilt", width, height, fov, generateTime,
+				(float)time[0] / frameCount, (float)time[1] / frameCount);
+		}
+	}
+
+	source.free();
+	dest.free();
+	return true;
+}
+
 bool Console::cmdSetPanoramaFoV(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Use %s <fieldOfView> to change the current panorama field of view\n", argv[0]);
@@ -29,6 +29,7 @@
 
 #include "zvision/file/lzss_read_stream.h"
 
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/system.h"
 #include "common/stream.h"
@@ -60,6 +61,8 @@ RenderManager::RenderManager(ZVision *engine, uint32 windowWidth, uint32 windowH
 
 	_menuArea = Common::Rect(0, 0, windowWidth, workingWindow.top);
 
+	_renderTable.setHighQuality(ConfMan.hasKey("hqpanorama") && ConfMan.getBool("hqpanorama"));
+
 	initSubArea(windowWidth, windowHeight, workingWindow);
 }
 
@@ -32,10 +32,18 @@ namespace ZVision {
 RenderTable::RenderTable(uint numColumns, uint numRows)
 	: _numRows(numRows),
 	  _numColumns(numColumns),
+	  _highQuality(false),
 	  _renderState(FLAT) {
 	assert(numRows != 0 && numColumns != 0);
 
 	_internalBuffer = new Common::Point[numRows * numColumns];
+	_sourceIndices = new uint32[numRows * numColumns];
+	_fractions = new uint8[numRows * numColumns];
+
+	for (uint32 i = 0; i < numRows * numColumns; ++i) {
+		_sourceIndices[i] = i;
+		_fractions[i] = 0;
+	}
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
@@ -43,6 +51,8 @@ RenderTable::RenderTable(uint numColumns, uint numRows)
 
 RenderTable::~RenderTable() {
 	delete[] _internalBuffer;
+	delete[] _sourceIndices;
+	delete[] _fractions;
 }
 
 void RenderTable::setRenderState(RenderState newState) {
@@ -89,41 +99,78 @@ void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 d
 	uint32 destOffset = 0;
 
 	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+		const uint32 *sourceIndices = &_sourceIndices[y * _numColumns + subRect.left];
+		uint16 *dest = &destBuffer[destOffset];
 
 		for (int16 x = subRect.left; x < subRect.right; ++x) {
-			uint32 normalizedX = x - subRect.left;
-			uint32 index = sourceOffset + x;
-
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
-
-			destBuffer[destOffset + normalizedX] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
+			*dest++ = sourceBuffer[*sourceIndices++];
 		}
 
 		destOffset += destWidth;
 	}
 }
 
+// The source indices follow the warp, so every pixel is a gather from an
+// arbitrary position. SSE2 and NEON have no gather loads, so a vector
+// version of this loop would still load one pixel at a time.
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
-	uint32 destOffset = 0;
+	if (_highQuality) {
+		mutateImageFiltered(dstBuf, srcBuf);
+		return;
+	}
 
 	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
 	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
 
 	for (int16 y = 0; y < srcBuf->h; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+		const uint32 *sourceIndices = &_sourceIndices[y * _numColumns];
 
 		for (int16 x = 0; x < srcBuf->w; ++x) {
-			uint32 index = sourceOffset + x;
+			*destBuffer++ = sourceBuffer[*sourceIndices++];
+		}
+	}
+}
+
+// Blends two 16 bit colors, with weight in 1/16ths of the second one. The red and blue
+// channels are blended together, since the green channel between them leaves enough room.
+static inline uint16 blendColors(uint16 color1, uint16 color2, uint weight, uint32 redBlueMask, uint32 greenMask) {
+	uint32 redBlue = (((color1 & redBlueMask) * (16 - weight) + (color2 & redBlueMask) * weight) >> 4) & redBlueMask;
+	uint32 green = (((color1 & greenMask) * (16 - weight) + (color2 & greenMask) * weight) >> 4) & greenMask;
+	return redBlue | green;
+}
 
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+void RenderTable::mutateImageFiltered(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
+	assert(srcBuf->format.bytesPerPixel == 2);
 
-			destBuffer[destOffset] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-			destOffset++;
+	const Graphics::PixelFormat &format = srcBuf->format;
+	uint32 redBlueMask = (format.rMax() << format.rShift) | (format.bMax() << format.bShift);
+	uint32 greenMask = format.gMax() << format.gShift;
+
+	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
+	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
+
+	for (int16 y = 0; y < srcBuf->h; ++y) {
+		uint32 index = y * _numColumns;
+
+		for (int16 x = 0; x < srcBuf->w; ++x, ++index) {
+			const uint16 *source = &sourceBuffer[_sourceIndices[index]];
+			uint fractionX = _fractions[index] & 0xF;
+			uint fractionY = _fractions[index] >> 4;
+
+			// The fractions are 0 at the right and bottom edges, so the neighbours are only read when they exist
+			uint16 color = source[0];
+			if (fractionX) {
+				color = blendColors(color, source[1], fractionX, redBlueMask, greenMask);
+			}
+			if (fractionY) {
+				uint16 colorBelow = source[_numColumns];
+				if (fractionX) {
+					colorBelow = blendColors(colorBelow, source[_numColumns + 1], fractionX, redBlueMask, greenMask);
+				}
+				color = blendColors(color, colorBelow, fractionY, redBlueMask, greenMask);
+			}
+
+			*destBuffer++ = color;
 		}
 	}
 }
@@ -144,6 +191,29 @@ void RenderTable::generateRenderTable() {
 	}
 }
 
+void RenderTable::setSourceCoord(uint x, uint y, float sourceX, float sourceY) {
+	int32 xInCylinderCoords = int32(floor(sourceX));
+	int32 yInCylinderCoords = int32(floor(sourceY));
+
+	uint32 index = y * _numColumns + x;
+
+	// Only store the (x,y) offsets instead of the absolute positions
+	_internalBuffer[index].x = xInCylinderCoords - x;
+	_internalBuffer[index].y = yInCylinderCoords - y;
+
+	_sourceIndices[index] = yInCylinderCoords * _numColumns + xInCylinderCoords;
+
+	uint8 fractionX = 0;
+	uint8 fractionY = 0;
+	if (xInCylinderCoords + 1 < (int32)_numColumns) {
+		fractionX = MIN<int>((sourceX - xInCylinderCoords) * 16.0f, 15);
+	}
+	if (yInCylinderCoords + 1 < (int32)_numRows) {
+		fractionY = MIN<int>((sourceY - yInCylinderCoords) * 16.0f, 15);
+	}
+	_fractions[index] = fractionX | (fractionY << 4);
+}
+
 void RenderTable::generatePanoramaLookupTable() {
 	for (uint y = 0; y < _numRows; y++) {
 		for (uint x = 0; x < _numColumns; x++) {
@@ -166,20 +236,16 @@ void RenderTable::generatePanoramaLookupTable() {
 
 		// To get x in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _panoramaOptions.linearScale
-		int32 xInCylinderCoords = int32(floor((cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth));
+		float xInCylinderCoords = (cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth;
 
 		float cosAlpha = cos(alpha);
 
 		for (uint y = 0; y < _numRows; ++y) {
 			// To calculate y in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-			int32 yInCylinderCoords = int32(floor(halfHeight + ((float)y - halfHeight) * cosAlpha));
+			float yInCylinderCoords = halfHeight + ((float)y - halfHeight) * cosAlpha;
 
-			uint32 index = y * _numColumns + x;
-
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			setSourceCoord(x, y, xInCylinderCoords, yInCylinderCoords);
 		}
 	}
 }
@@ -200,21 +266,16 @@ void RenderTable::generateTiltLookupTable() {
 
 		// To get y in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _tiltOptions.linearScale
-		int32 yInCylinderCoords = int32(floor((cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight));
+		float yInCylinderCoords = (cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight;
 
 		float cosAlpha = cos(alpha);
-		uint32 columnIndex = y * _numColumns;
 
 		for (uint x = 0; x < _numColumns; ++x) {
 			// To calculate x in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-			int32 xInCylinderCoords = int32(floor(halfWidth + ((float)x - halfWidth) * cosAlpha));
-
-			uint32 index = columnIndex + x;
+			float xInCylinderCoords = halfWidth + ((float)x - halfWidth) * cosAlpha;
 
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			setSourceCoord(x, y, xInCylinderCoords, yInCylinderCoords);
 		}
 	}
 }
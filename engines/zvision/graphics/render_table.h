@@ -43,6 +43,11 @@ public:
 private:
 	uint _numColumns, _numRows;
 	Common::Point *_internalBuffer;
+	// The source pixel index of each pixel, so that mutating an image is a plain lookup
+	uint32 *_sourceIndices;
+	// The fractional part of each source coordinate in 1/16ths, x in the low nibble and y in the high one
+	uint8 *_fractions;
+	bool _highQuality;
 	RenderState _renderState;
 
 	struct {
@@ -72,6 +77,16 @@ public:
 	void mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf);
 	void generateRenderTable();
 
+	/**
+	 * When enabled, mutateImage() filters the image bilinearly instead of taking the nearest pixel
+	 */
+	void setHighQuality(bool highQuality) {
+		_highQuality = highQuality;
+	}
+	bool getHighQuality() {
+		return _highQuality;
+	}
+
 	void setPanoramaFoV(float fov);
 	void setPanoramaScale(float scale);
 	void setPanoramaReverse(bool reverse);
@@ -90,6 +105,8 @@ public:
 private:
 	void generatePanoramaLookupTable();
 	void generateTiltLookupTable();
+	void setSourceCoord(uint x, uint y, float sourceX, float sourceY);
+	void mutateImageFiltered(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf);
 };
 
 } // End of namespace ZVision
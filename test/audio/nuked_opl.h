@@ -0,0 +1,115 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/opl/nuked.h"
+
+#include "common/util.h"
+
+// A register write log: each write happens after the given number of output samples
+struct NukedOplLogEntry {
+	uint16 delay;
+	uint16 reg;
+	uint8 val;
+};
+
+static const NukedOplLogEntry nukedOplLog[] = {
+	// OPL3 mode, waveform select, two 4-op channels
+	{   0, 0x105, 0x01 }, {   0, 0x001, 0x20 }, {   0, 0x104, 0x03 },
+	{   0, 0x0bd, 0xc0 },
+	// Channel 0 (4-op with channel 3): different waveforms, vibrato and tremolo
+	{   0, 0x020, 0xa1 }, {   0, 0x023, 0x61 }, {   0, 0x028, 0x32 }, {   0, 0x02b, 0x01 },
+	{   0, 0x040, 0x1a }, {   0, 0x043, 0x00 }, {   0, 0x048, 0x20 }, {   0, 0x04b, 0x05 },
+	{   0, 0x060, 0xf2 }, {   0, 0x063, 0xa4 }, {   0, 0x068, 0xc3 }, {   0, 0x06b, 0x82 },
+	{   0, 0x080, 0x53 }, {   0, 0x083, 0x26 }, {   0, 0x088, 0x44 }, {   0, 0x08b, 0x17 },
+	{   0, 0x0e0, 0x01 }, {   0, 0x0e3, 0x04 }, {   0, 0x0e8, 0x06 }, {   0, 0x0eb, 0x00 },
+	{   0, 0x0c0, 0x3e }, {   0, 0x0c3, 0x31 },
+	// Channel 1 (2-op) with feedback, panned right
+	{   0, 0x021, 0x01 }, {   0, 0x024, 0x02 }, {   0, 0x041, 0x10 }, {   0, 0x044, 0x03 },
+	{   0, 0x061, 0xf5 }, {   0, 0x064, 0xf3 }, {   0, 0x081, 0x77 }, {   0, 0x084, 0x0c },
+	{   0, 0x0e1, 0x02 }, {   0, 0x0e4, 0x07 }, {   0, 0x0c1, 0x2b },
+	// Channel 9 on the second register set
+	{   0, 0x120, 0x42 }, {   0, 0x123, 0x21 }, {   0, 0x140, 0x0c }, {   0, 0x143, 0x08 },
+	{   0, 0x160, 0xe8 }, {   0, 0x163, 0xd6 }, {   0, 0x180, 0x25 }, {   0, 0x183, 0x35 },
+	{   0, 0x1e0, 0x05 }, {   0, 0x1e3, 0x03 }, {   0, 0x1c0, 0x1c },
+	// Rhythm instruments
+	{   0, 0x030, 0x01 }, {   0, 0x033, 0x01 }, {   0, 0x050, 0x0f }, {   0, 0x053, 0x00 },
+	{   0, 0x070, 0xf8 }, {   0, 0x073, 0xf6 }, {   0, 0x090, 0x47 }, {   0, 0x093, 0x67 },
+	{   0, 0x031, 0x01 }, {   0, 0x034, 0x01 }, {   0, 0x051, 0x00 }, {   0, 0x054, 0x00 },
+	{   0, 0x071, 0xf8 }, {   0, 0x074, 0xf7 }, {   0, 0x091, 0x75 }, {   0, 0x094, 0x55 },
+	{   0, 0x032, 0x05 }, {   0, 0x035, 0x01 }, {   0, 0x052, 0x00 }, {   0, 0x055, 0x03 },
+	{   0, 0x072, 0xf9 }, {   0, 0x075, 0xf8 }, {   0, 0x092, 0x66 }, {   0, 0x095, 0x46 },
+	{   0, 0x0c6, 0x30 }, {   0, 0x0c7, 0x30 }, {   0, 0x0c8, 0x30 },
+	{   0, 0x0a6, 0x57 }, {   0, 0x0b6, 0x09 }, {   0, 0x0a7, 0x03 }, {   0, 0x0b7, 0x0a },
+	{   0, 0x0a8, 0x41 }, {   0, 0x0b8, 0x09 },
+	// Notes on
+	{   0, 0x0a0, 0x6b }, {   0, 0x0b0, 0x31 },
+	{ 300, 0x0a1, 0x81 }, {   0, 0x0b1, 0x2d },
+	{ 500, 0x1a0, 0x98 }, {   0, 0x1b0, 0x3a },
+	{ 200, 0x0bd, 0xff },
+	{ 900, 0x0bd, 0xe0 },
+	// Pitch changes and key offs while notes are sounding
+	{ 1200, 0x0a0, 0xe5 }, {   0, 0x0b0, 0x31 },
+	{ 700, 0x0b1, 0x0d },
+	{ 100, 0x0bd, 0xf6 },
+	{ 1500, 0x0b0, 0x11 },
+	{ 600, 0x041, 0x3f }, {   0, 0x0c1, 0x25 },
+	{ 100, 0x0a1, 0x45 }, {   0, 0x0b1, 0x32 },
+	{ 2000, 0x1b0, 0x1a },
+	{ 800, 0x0bd, 0x20 },
+	{ 400, 0x0b1, 0x12 },
+	{ 4000, 0x000, 0x00 }
+};
+
+class NukedOplTestSuite : public CxxTest::TestSuite
+{
+private:
+	/**
+	 * Plays back the register log at the given sample rate, generating
+	 * the given number of samples per call, and hashes the output
+	 */
+	uint32 playLog(uint32 rate, uint32 blockSize, bool perSample) {
+		OPL::NUKED::opl3_chip *chip = new OPL::NUKED::opl3_chip;
+		OPL::NUKED::OPL3_Reset(chip, rate);
+
+		uint32 hash = 2166136261U;
+		int16 buffer[2 * 256];
+
+		for (uint i = 0; i < ARRAYSIZE(nukedOplLog); ++i) {
+			uint32 remaining = nukedOplLog[i].delay;
+			while (remaining) {
+				uint32 count = MIN(remaining, blockSize);
+				if (perSample) {
+					for (uint32 j = 0; j < count; ++j)
+						OPL::NUKED::OPL3_GenerateResampled(chip, buffer + j * 2);
+				} else {
+					OPL::NUKED::OPL3_GenerateStream(chip, buffer, count);
+				}
+
+				for (uint32 j = 0; j < count * 2; ++j) {
+					hash = (hash ^ (uint16)buffer[j]) * 16777619U;
+				}
+				remaining -= count;
+			}
+
+			OPL::NUKED::OPL3_WriteRegBuffered(chip, nukedOplLog[i].reg, nukedOplLog[i].val);
+		}
+
+		delete chip;
+		return hash;
+	}
+
+public:
+	void test_stream_matches_reference_44100() {
+		TS_ASSERT_EQUALS(playLog(44100, 256, false), 1685183161U);
+	}
+
+	void test_stream_matches_reference_native_rate() {
+		TS_ASSERT_EQUALS(playLog(49716, 256, false), 3083764185U);
+	}
+
+	void test_block_sizes_match_per_sample() {
+		uint32 reference = playLog(22050, 1, true);
+		TS_ASSERT_EQUALS(playLog(22050, 1, false), reference);
+		TS_ASSERT_EQUALS(playLog(22050, 7, false), reference);
+		TS_ASSERT_EQUALS(playLog(22050, 256, false), reference);
+	}
+};
@@ -5,9 +5,13 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h
+TESTS        := $(srcdir)/test/common/*.h $(filter-out $(srcdir)/test/audio/nuked_opl.h,$(wildcard $(srcdir)/test/audio/*.h))
 TEST_LIBS    := audio/libaudio.a common/libcommon.a
 
+ifndef DISABLE_NUKED_OPL
+	TESTS += $(srcdir)/test/audio/nuked_opl.h
+endif
+
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
 	TEST_LIBS += engines/wintermute/libwintermute.a